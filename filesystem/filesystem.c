@@ -81,6 +81,33 @@ lfs_t eeprom_filesystem;
 static lfs_file_t file;
 static struct lfs_info info;
 
+// Files opened with filesystem_open. Each gets its own cache buffer, so none of this touches the heap.
+typedef struct {
+    lfs_file_t file;
+    struct lfs_file_config config;
+    uint8_t buffer[NVMCTRL_PAGE_SIZE];
+    bool is_open;
+} filesystem_open_file_t;
+
+static filesystem_open_file_t _open_files[FILESYSTEM_MAX_OPEN_FILES];
+
+// filesystem_read_line keeps its file open between calls, so a loop reading line after line makes one pass.
+static filesystem_line_reader_t _read_line_reader;
+static char _read_line_buffer[NVMCTRL_PAGE_SIZE * 2];
+static char _read_line_filename[LFS_NAME_MAX + 1];
+static bool _read_line_reader_is_open;
+
+static void _filesystem_close_read_line_reader(void);
+
+// The key-value store is a log of fixed-size records in one file: a put appends a record, and a get returns the
+// value of the last record with that key. When the log grows past _kv_compact_size, it's rewritten with just the
+// latest record for each key.
+#define FILESYSTEM_KV_FILENAME "kv.log"
+#define FILESYSTEM_KV_TEMP_FILENAME "kv.tmp"
+#define FILESYSTEM_KV_RECORD_SIZE 6
+
+static int32_t _kv_compact_size = NVMCTRL_ROW_SIZE;
+
 static int _traverse_df_cb(void *p, lfs_block_t block) {
     (void) block;
 	uint32_t *nb = p;
@@ -157,6 +184,7 @@ bool filesystem_init(void) {
 
 int _filesystem_format(void);
 int _filesystem_format(void) {
+    _filesystem_close_read_line_reader();
     int err = lfs_unmount(&eeprom_filesystem);
     if (err < 0) {
         printf("Couldn't unmount - continuing to format, but you should reboot afterwards!\r\n");
@@ -178,6 +206,7 @@ bool filesystem_file_exists(char *filename) {
 }
 
 bool filesystem_rm(char *filename) {
+    _filesystem_close_read_line_reader();
     info.type = 0;
     lfs_stat(&eeprom_filesystem, filename, &info);
     if (filesystem_file_exists(filename)) {
@@ -188,6 +217,11 @@ bool filesystem_rm(char *filename) {
     }
 }
 
+bool filesystem_rename(char *old_filename, char *new_filename) {
+    _filesystem_close_read_line_reader();
+    return lfs_rename(&eeprom_filesystem, old_filename, new_filename) == LFS_ERR_OK;
+}
+
 int32_t filesystem_get_file_size(char *filename) {
     if (filesystem_file_exists(filename)) {
         return info.size; // info struct was just populated by filesystem_file_exists
@@ -198,60 +232,275 @@ int32_t filesystem_get_file_size(char *filename) {
 
 bool filesystem_read_file(char *filename, char *buf, int32_t length) {
     memset(buf, 0, length);
-    int32_t file_size = filesystem_get_file_size(filename);
+    // opening the file tells us whether it exists, and its size, without a separate lfs_stat.
+    int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_RDONLY);
+    if (err < 0) return false;
+    int32_t file_size = lfs_file_size(&eeprom_filesystem, &file);
     if (file_size > 0) {
-        int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_RDONLY);
-        if (err < 0) return false;
         err = lfs_file_read(&eeprom_filesystem, &file, buf, min(length, file_size));
-        if (err < 0) return false;
+        if (err < 0) {
+            lfs_file_close(&eeprom_filesystem, &file);
+            return false;
+        }
         return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK;
     }
 
+    lfs_file_close(&eeprom_filesystem, &file);
     return false;
 }
 
-bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t length) {
-    memset(buf, 0, length + 1);
-    int32_t file_size = filesystem_get_file_size(filename);
-    if (file_size > 0) {
-        int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_RDONLY);
-        if (err < 0) return false;
-        err = lfs_file_seek(&eeprom_filesystem, &file, *offset, LFS_SEEK_SET);
-        if (err < 0) return false;
-        err = lfs_file_read(&eeprom_filesystem, &file, buf, min(length - 1, file_size - *offset));
-        if (err < 0) return false;
-        for(int i = 0; i < length; i++) {
-            (*offset)++;
-            if (buf[i] == '\n') {
-                buf[i] = 0;
-                break;
+static lfs_file_t *_filesystem_get_open_file(filesystem_handle_t handle) {
+    if (handle < 0 || handle >= FILESYSTEM_MAX_OPEN_FILES || !_open_files[handle].is_open) return NULL;
+
+    return &_open_files[handle].file;
+}
+
+filesystem_handle_t filesystem_open(char *filename, filesystem_open_mode_t mode) {
+    int flags;
+
+    switch (mode) {
+        case FILESYSTEM_OPEN_READ:
+            flags = LFS_O_RDONLY;
+            break;
+        case FILESYSTEM_OPEN_APPEND:
+        case FILESYSTEM_OPEN_WRITE:
+            // check for space once here, rather than on every append like filesystem_append_file does.
+            if (filesystem_get_free_space() <= 256) {
+                printf("No free space!\n");
+                return -1;
             }
-        }
-        return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK;
+            flags = LFS_O_WRONLY | LFS_O_CREAT | (mode == FILESYSTEM_OPEN_APPEND ? LFS_O_APPEND : LFS_O_TRUNC);
+            break;
+        default:
+            return -1;
     }
 
-    return false;
+    // the file filesystem_read_line keeps open is fair game if we're out of handles.
+    bool all_open = true;
+    for (filesystem_handle_t handle = 0; handle < FILESYSTEM_MAX_OPEN_FILES; handle++) {
+        all_open &= _open_files[handle].is_open;
+    }
+    if (all_open) _filesystem_close_read_line_reader();
+
+    for (filesystem_handle_t handle = 0; handle < FILESYSTEM_MAX_OPEN_FILES; handle++) {
+        filesystem_open_file_t *open_file = &_open_files[handle];
+        if (open_file->is_open) continue;
+
+        open_file->config = (struct lfs_file_config) { .buffer = open_file->buffer };
+        if (lfs_file_opencfg(&eeprom_filesystem, &open_file->file, filename, flags, &open_file->config) < 0) return -1;
+        open_file->is_open = true;
+
+        return handle;
+    }
+
+    printf("Too many open files!\n");
+    return -1;
 }
 
-static void filesystem_cat(char *filename) {
-    info.type = 0;
-    lfs_stat(&eeprom_filesystem, filename, &info);
-    if (filesystem_file_exists(filename)) {
-        if (info.size > 0) {
-            char *buf = malloc(info.size + 1);
-            filesystem_read_file(filename, buf, info.size);
-            buf[info.size] = '\0';
-            printf("%s\r\n", buf);
-            free(buf);
+int32_t filesystem_readline(filesystem_handle_t handle, char *buf, int32_t length) {
+    lfs_file_t *open_file = _filesystem_get_open_file(handle);
+    if (open_file == NULL || length < 1) return -1;
+
+    buf[0] = 0;
+    lfs_soff_t start = lfs_file_tell(&eeprom_filesystem, open_file);
+    lfs_ssize_t bytes_read = lfs_file_read(&eeprom_filesystem, open_file, buf, length - 1);
+    if (bytes_read <= 0) return -1;
+
+    int32_t line_length = bytes_read;
+    char *newline = memchr(buf, '\n', bytes_read);
+    if (newline != NULL) {
+        // we read past the end of the line, so put the cursor back at the start of the next one.
+        line_length = newline - buf;
+        lfs_file_seek(&eeprom_filesystem, open_file, start + line_length + 1, LFS_SEEK_SET);
+    } else if (bytes_read == length - 1) {
+        // the line didn't fit; skip the rest of it. this is all coming from the file's cache.
+        char c;
+        while (lfs_file_read(&eeprom_filesystem, open_file, &c, 1) == 1 && c != '\n');
+    }
+    buf[line_length] = 0;
+
+    return line_length;
+}
+
+int32_t filesystem_read(filesystem_handle_t handle, char *buf, int32_t length) {
+    lfs_file_t *open_file = _filesystem_get_open_file(handle);
+    if (open_file == NULL) return -1;
+
+    lfs_ssize_t bytes_read = lfs_file_read(&eeprom_filesystem, open_file, buf, length);
+
+    return bytes_read < 0 ? -1 : bytes_read;
+}
+
+bool filesystem_append(filesystem_handle_t handle, char *text, int32_t length) {
+    lfs_file_t *open_file = _filesystem_get_open_file(handle);
+    if (open_file == NULL) return false;
+
+    return lfs_file_write(&eeprom_filesystem, open_file, text, length) == length;
+}
+
+int32_t filesystem_tell(filesystem_handle_t handle) {
+    lfs_file_t *open_file = _filesystem_get_open_file(handle);
+    if (open_file == NULL) return -1;
+
+    return lfs_file_tell(&eeprom_filesystem, open_file);
+}
+
+bool filesystem_seek(filesystem_handle_t handle, int32_t offset) {
+    lfs_file_t *open_file = _filesystem_get_open_file(handle);
+    if (open_file == NULL) return false;
+
+    return lfs_file_seek(&eeprom_filesystem, open_file, offset, LFS_SEEK_SET) >= 0;
+}
+
+bool filesystem_close(filesystem_handle_t handle) {
+    lfs_file_t *open_file = _filesystem_get_open_file(handle);
+    if (open_file == NULL) return false;
+
+    _open_files[handle].is_open = false;
+
+    // anything appended is written out here.
+    return lfs_file_close(&eeprom_filesystem, open_file) == LFS_ERR_OK;
+}
+
+bool filesystem_line_reader_open(filesystem_line_reader_t *reader, char *filename, char *buffer, int32_t size) {
+    if (size < 2) return false;
+
+    *reader = (filesystem_line_reader_t) {
+        .handle = filesystem_open(filename, FILESYSTEM_OPEN_READ),
+        .buffer = buffer,
+        .size = size,
+    };
+
+    return reader->handle >= 0;
+}
+
+bool filesystem_line_reader_seek(filesystem_line_reader_t *reader, int32_t offset) {
+    if (!filesystem_seek(reader->handle, offset)) return false;
+
+    reader->start = reader->end = 0;
+    reader->offset = offset;
+    reader->at_end = false;
+
+    return true;
+}
+
+char *filesystem_line_reader_next(filesystem_line_reader_t *reader, int32_t *length) {
+    lfs_file_t *open_file = _filesystem_get_open_file(reader->handle);
+    if (open_file == NULL) return NULL;
+
+    while (true) {
+        char *line = reader->buffer + reader->start;
+        int32_t available = reader->end - reader->start;
+        char *newline = memchr(line, '\n', available);
+        int32_t line_length;
+
+        if (newline != NULL) {
+            line_length = newline - line;
+            reader->start += line_length + 1;
+            reader->offset += line_length + 1;
+        } else if (reader->at_end || (reader->start == 0 && reader->end == reader->size - 1)) {
+            // the last line in the file, or one that won't fit in the buffer; the rest of it comes next time.
+            if (available == 0) return NULL;
+            line_length = available;
+            reader->start = reader->end;
+            reader->offset += line_length;
         } else {
-            printf("\r\n");
+            // move what's left of the line to the front, and fill the rest of the buffer from the file.
+            memmove(reader->buffer, line, available);
+            reader->start = 0;
+            reader->end = available;
+
+            // littlefs reads whole multiples of its cache size straight into our buffer, without copying.
+            int32_t space = reader->size - 1 - reader->end;
+            if (space >= watch_lfs_cfg.cache_size) space -= space % watch_lfs_cfg.cache_size;
+            lfs_ssize_t bytes_read = lfs_file_read(&eeprom_filesystem, open_file, reader->buffer + reader->end, space);
+            if (bytes_read <= 0) reader->at_end = true;
+            else reader->end += bytes_read;
+            continue;
         }
+
+        line[line_length] = 0;
+        if (length != NULL) *length = line_length;
+
+        return line;
+    }
+}
+
+int32_t filesystem_line_reader_tell(filesystem_line_reader_t *reader) {
+    return reader->offset;
+}
+
+void filesystem_line_reader_close(filesystem_line_reader_t *reader) {
+    filesystem_close(reader->handle);
+    reader->handle = -1;
+}
+
+static void _filesystem_close_read_line_reader(void) {
+    if (!_read_line_reader_is_open) return;
+
+    filesystem_line_reader_close(&_read_line_reader);
+    _read_line_reader_is_open = false;
+}
+
+bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t length) {
+    memset(buf, 0, length + 1);
+
+    // pick up where the last call left off if we can; otherwise (re)open the file and seek to the offset.
+    if (!_read_line_reader_is_open
+        || strncmp(filename, _read_line_filename, LFS_NAME_MAX)
+        || filesystem_line_reader_tell(&_read_line_reader) != *offset) {
+        _filesystem_close_read_line_reader();
+        if (!filesystem_line_reader_open(&_read_line_reader, filename, _read_line_buffer, sizeof(_read_line_buffer))) return false;
+        _read_line_reader_is_open = true;
+        strncpy(_read_line_filename, filename, LFS_NAME_MAX);
+
+        lfs_file_t *open_file = _filesystem_get_open_file(_read_line_reader.handle);
+        if (lfs_file_size(&eeprom_filesystem, open_file) <= 0 || !filesystem_line_reader_seek(&_read_line_reader, *offset)) {
+            _filesystem_close_read_line_reader();
+            return false;
+        }
+    }
+
+    int32_t line_offset = *offset;
+    int32_t line_length;
+    char *line = filesystem_line_reader_next(&_read_line_reader, &line_length);
+    if (line == NULL) {
+        // at the end of the file, you get an empty line.
+        _filesystem_close_read_line_reader();
+        return true;
+    }
+
+    if (line_length > length - 1) {
+        // only part of it fits in your buffer; the next call will read the rest.
+        line_length = length - 1;
+        *offset = line_offset + line_length;
     } else {
+        *offset = filesystem_line_reader_tell(&_read_line_reader);
+    }
+    memcpy(buf, line, line_length);
+
+    return true;
+}
+
+static void filesystem_cat(char *filename) {
+    filesystem_handle_t handle = filesystem_open(filename, FILESYSTEM_OPEN_READ);
+    if (handle < 0) {
         printf("cat: %s: No such file\r\n", filename);
+        return;
     }
+
+    // stream it out a cache's worth at a time, rather than reading the whole file into RAM first.
+    char buf[NVMCTRL_PAGE_SIZE];
+    int32_t bytes_read;
+    while ((bytes_read = filesystem_read(handle, buf, sizeof(buf))) > 0) {
+        fwrite(buf, 1, bytes_read, stdout);
+    }
+    filesystem_close(handle);
+    printf("\r\n");
 }
 
 bool filesystem_write_file(char *filename, char *text, int32_t length) {
+    _filesystem_close_read_line_reader();
     if (filesystem_get_free_space() <= 256) {
         printf("No free space!\n");
         return false;    
@@ -265,6 +514,7 @@ bool filesystem_write_file(char *filename, char *text, int32_t length) {
 }
 
 bool filesystem_append_file(char *filename, char *text, int32_t length) {
+    _filesystem_close_read_line_reader();
     if (filesystem_get_free_space() <= 256) {
         printf("No free space!\n");
         return false;    
@@ -294,30 +544,239 @@ int filesystem_cmd_cat(int argc, char *argv[]) {
 
 int filesystem_cmd_b64encode(int argc, char *argv[]) {
     (void) argc;
-    info.type = 0;
-    lfs_stat(&eeprom_filesystem, argv[1], &info);
-    if (filesystem_file_exists(argv[1])) {
-        if (info.size > 0) {
-            char *buf = malloc(info.size + 1);
-            filesystem_read_file(argv[1], buf, info.size);
-            // print a base 64 encoding of the file, 12 bytes at a time
-            for (lfs_size_t i = 0; i < info.size; i += 12) {
-                lfs_size_t len = min(12, info.size - i);
-                char base64_line[17];
-                b64_encode((unsigned char *)buf + i, len, (unsigned char *)base64_line);
-                printf("%s\n", base64_line);
-                delay_ms(10);
-            }
-            free(buf);
-        } else {
-            printf("\r\n");
-        }
-    } else {
+    filesystem_handle_t handle = filesystem_open(argv[1], FILESYSTEM_OPEN_READ);
+    if (handle < 0) {
         printf("b64encode: %s: No such file\r\n", argv[1]);
+        return 0;
+    }
+
+    // print a base 64 encoding of the file, 12 bytes at a time, reading four lines' worth per chunk.
+    char buf[48];
+    int32_t bytes_read;
+    bool empty = true;
+    while ((bytes_read = filesystem_read(handle, buf, sizeof(buf))) > 0) {
+        for (int32_t i = 0; i < bytes_read; i += 12) {
+            int32_t len = min(12, bytes_read - i);
+            char base64_line[17];
+            b64_encode((unsigned char *)buf + i, len, (unsigned char *)base64_line);
+            printf("%s\n", base64_line);
+        }
+        empty = false;
+        // a short read means we're at the end of the file.
+        if (bytes_read < (int32_t)sizeof(buf)) break;
     }
+    filesystem_close(handle);
+    if (empty) printf("\r\n");
+
     return 0;
 }
 
+// Binary file transfer for the get and put commands; utils/watch_file_transfer.py is the other end.
+//
+// Every reply from the watch starts with a control byte, so the host can skip the shell's echo of the command:
+// ACK to go ahead, or NAK followed by a line of text explaining why not. Data moves in chunks framed as a 16-bit
+// length, the bytes, and their CRC-32, all little-endian. The receiver answers each chunk with ACK to get the next
+// one, NAK to have it sent again, or CAN to give up.
+//
+//   get <PATH>:         watch sends ACK, the 32-bit file size, then chunks of up to FILESYSTEM_TRANSFER_GET_CHUNK_SIZE.
+//   put <PATH> <SIZE>:  watch sends ACK and the largest chunk it takes, then the host sends chunks until SIZE bytes
+//                       have arrived. They go into FILESYSTEM_TRANSFER_TEMP_FILENAME, which only replaces PATH once
+//                       it's safely closed; the watch ACKs the last chunk after that, and a failed put leaves PATH alone.
+#define FILESYSTEM_TRANSFER_ACK 0x06
+#define FILESYSTEM_TRANSFER_NAK 0x15
+#define FILESYSTEM_TRANSFER_CAN 0x18
+#define FILESYSTEM_TRANSFER_GET_CHUNK_SIZE 256
+// this has to fit in the USB serial driver's receive buffer, along with its framing.
+#define FILESYSTEM_TRANSFER_PUT_CHUNK_SIZE 128
+#define FILESYSTEM_TRANSFER_TIMEOUT_MS 2000
+#define FILESYSTEM_TRANSFER_MAX_RETRIES 3
+#define FILESYSTEM_TRANSFER_TEMP_FILENAME "put.tmp"
+
+// defined in movement.c; services USB while we wait for the host.
+void yield(void);
+
+static uint32_t _filesystem_crc32(uint32_t crc, const uint8_t *data, int32_t length) {
+    // half-byte table: 64 bytes of flash, and plenty fast next to the USB link.
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+
+    crc = ~crc;
+    for (int32_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+
+    return ~crc;
+}
+
+static int _filesystem_transfer_getc(void) {
+    for (uint16_t waited = 0; waited < FILESYSTEM_TRANSFER_TIMEOUT_MS; waited++) {
+        int c = getchar();
+        if (c >= 0) return c;
+        yield();
+        delay_ms(1);
+    }
+
+    return -1;
+}
+
+static bool _filesystem_transfer_read(uint8_t *buf, int32_t length) {
+    for (int32_t i = 0; i < length; i++) {
+        int c = _filesystem_transfer_getc();
+        if (c < 0) return false;
+        buf[i] = c;
+    }
+
+    return true;
+}
+
+static void _filesystem_transfer_write(const void *buf, int32_t length) {
+    fwrite(buf, 1, length, stdout);
+}
+
+static void _filesystem_transfer_reply(uint8_t reply) {
+    _filesystem_transfer_write(&reply, 1);
+    fflush(stdout);
+}
+
+static void _filesystem_transfer_refuse(const char *command, const char *path, const char *reason) {
+    _filesystem_transfer_reply(FILESYSTEM_TRANSFER_NAK);
+    printf("%s: %s: %s\r\n", command, path, reason);
+}
+
+static void _filesystem_transfer_pack_u32(uint8_t *buf, uint32_t value) {
+    buf[0] = value & 0xFF;
+    buf[1] = (value >> 8) & 0xFF;
+    buf[2] = (value >> 16) & 0xFF;
+    buf[3] = value >> 24;
+}
+
+static uint32_t _filesystem_transfer_unpack_u32(const uint8_t *buf) {
+    return buf[0] | (buf[1] << 8) | (buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+int filesystem_cmd_get(int argc, char *argv[]) {
+    (void) argc;
+    int32_t size = filesystem_get_file_size(argv[1]);
+    filesystem_handle_t handle = size < 0 ? -1 : filesystem_open(argv[1], FILESYSTEM_OPEN_READ);
+    if (handle < 0) {
+        _filesystem_transfer_refuse("get", argv[1], "No such file");
+        return 1;
+    }
+
+    uint8_t header[5] = { FILESYSTEM_TRANSFER_ACK };
+    _filesystem_transfer_pack_u32(header + 1, size);
+    _filesystem_transfer_write(header, sizeof(header));
+
+    uint8_t chunk[2 + FILESYSTEM_TRANSFER_GET_CHUNK_SIZE + 4];
+    int32_t offset = 0;
+    uint8_t retries = 0;
+    while (offset < size) {
+        int32_t length = filesystem_read(handle, (char *)chunk + 2, FILESYSTEM_TRANSFER_GET_CHUNK_SIZE);
+        if (length <= 0) break;
+
+        chunk[0] = length & 0xFF;
+        chunk[1] = length >> 8;
+        _filesystem_transfer_pack_u32(chunk + 2 + length, _filesystem_crc32(0, chunk + 2, length));
+        _filesystem_transfer_write(chunk, 2 + length + 4);
+        fflush(stdout);
+
+        int reply = _filesystem_transfer_getc();
+        if (reply == FILESYSTEM_TRANSFER_ACK) {
+            offset += length;
+            retries = 0;
+        } else if (reply == FILESYSTEM_TRANSFER_NAK && retries++ < FILESYSTEM_TRANSFER_MAX_RETRIES) {
+            filesystem_seek(handle, offset);
+        } else {
+            break;
+        }
+    }
+    filesystem_close(handle);
+
+    return offset == size ? 0 : 1;
+}
+
+int filesystem_cmd_put(int argc, char *argv[]) {
+    (void) argc;
+    char *end;
+    long size = strtol(argv[2], &end, 10);
+    if (end == argv[2] || *end != '\0' || size <= 0) {
+        _filesystem_transfer_refuse("put", argv[1], "size must be a positive number");
+        return 1;
+    }
+    if (strchr(argv[1], '/')) {
+        _filesystem_transfer_refuse("put", argv[1], "subdirectories are not supported");
+        return 1;
+    }
+    if (size > filesystem_get_free_space() - 256) {
+        _filesystem_transfer_refuse("put", argv[1], "No free space");
+        return 1;
+    }
+
+    _filesystem_close_read_line_reader();
+    filesystem_handle_t handle = filesystem_open(FILESYSTEM_TRANSFER_TEMP_FILENAME, FILESYSTEM_OPEN_WRITE);
+    if (handle < 0) {
+        _filesystem_transfer_refuse("put", argv[1], "Couldn't open file");
+        return 1;
+    }
+
+    uint8_t header[3] = { FILESYSTEM_TRANSFER_ACK, FILESYSTEM_TRANSFER_PUT_CHUNK_SIZE & 0xFF, FILESYSTEM_TRANSFER_PUT_CHUNK_SIZE >> 8 };
+    _filesystem_transfer_write(header, sizeof(header));
+    fflush(stdout);
+
+    uint8_t chunk[FILESYSTEM_TRANSFER_PUT_CHUNK_SIZE + 4];
+    int32_t received = 0;
+    uint8_t retries = 0;
+    bool ok = true;
+    while (received < size) {
+        uint8_t prefix[2];
+        if (!_filesystem_transfer_read(prefix, 2)) {
+            ok = false;
+            break;
+        }
+        int32_t length = prefix[0] | (prefix[1] << 8);
+        if (length == 0 || length > FILESYSTEM_TRANSFER_PUT_CHUNK_SIZE || length > size - received ||
+            !_filesystem_transfer_read(chunk, length + 4)) {
+            // we've lost track of the framing; there's no getting it back.
+            ok = false;
+            break;
+        }
+
+        if (_filesystem_crc32(0, chunk, length) != _filesystem_transfer_unpack_u32(chunk + length)) {
+            if (retries++ == FILESYSTEM_TRANSFER_MAX_RETRIES) {
+                ok = false;
+                break;
+            }
+            _filesystem_transfer_reply(FILESYSTEM_TRANSFER_NAK);
+            continue;
+        }
+        retries = 0;
+
+        if (!filesystem_append(handle, (char *)chunk, length)) {
+            ok = false;
+            break;
+        }
+        received += length;
+        // the last chunk is acknowledged below, once the file is closed.
+        if (received < size) _filesystem_transfer_reply(FILESYSTEM_TRANSFER_ACK);
+    }
+
+    ok = filesystem_close(handle) && ok;
+    if (ok) {
+        // the whole file is in, so it can take the old one's place in a single commit.
+        ok = lfs_rename(&eeprom_filesystem, FILESYSTEM_TRANSFER_TEMP_FILENAME, argv[1]) >= 0;
+    }
+    if (!ok) {
+        // don't leave half a file behind; whatever was at the path before is still there.
+        lfs_remove(&eeprom_filesystem, FILESYSTEM_TRANSFER_TEMP_FILENAME);
+    }
+    _filesystem_transfer_reply(ok ? FILESYSTEM_TRANSFER_ACK : FILESYSTEM_TRANSFER_CAN);
+
+    return ok ? 0 : 1;
+}
+
 int filesystem_cmd_df(int argc, char *argv[]) {
     (void) argc;
     (void) argv;
@@ -369,3 +828,172 @@ int filesystem_cmd_echo(int argc, char *argv[]) {
 
     return 0;
 }
+
+static void _filesystem_kv_pack(uint8_t *record, uint16_t key, uint32_t value) {
+    record[0] = key & 0xFF;
+    record[1] = key >> 8;
+    record[2] = value & 0xFF;
+    record[3] = (value >> 8) & 0xFF;
+    record[4] = (value >> 16) & 0xFF;
+    record[5] = value >> 24;
+}
+
+static uint16_t _filesystem_kv_key(const uint8_t *record) {
+    return record[0] | (record[1] << 8);
+}
+
+static uint32_t _filesystem_kv_value(const uint8_t *record) {
+    return record[2] | (record[3] << 8) | (record[4] << 16) | ((uint32_t)record[5] << 24);
+}
+
+bool filesystem_kv_get(uint16_t key, uint32_t *value) {
+    // this has a file of its own, so that it doesn't disturb the line reader's.
+    lfs_file_t kv_file;
+    int err = lfs_file_open(&eeprom_filesystem, &kv_file, FILESYSTEM_KV_FILENAME, LFS_O_RDONLY);
+    if (err < 0) return false;
+
+    // a handful of records at a time; the last one with our key wins.
+    uint8_t records[FILESYSTEM_KV_RECORD_SIZE * 8];
+    bool found = false;
+    lfs_ssize_t bytes_read;
+    while ((bytes_read = lfs_file_read(&eeprom_filesystem, &kv_file, records, sizeof(records))) > 0) {
+        for (lfs_ssize_t i = 0; i + FILESYSTEM_KV_RECORD_SIZE <= bytes_read; i += FILESYSTEM_KV_RECORD_SIZE) {
+            if (_filesystem_kv_key(records + i) == key) {
+                *value = _filesystem_kv_value(records + i);
+                found = true;
+            }
+        }
+    }
+
+    lfs_file_close(&eeprom_filesystem, &kv_file);
+    return found;
+}
+
+static bool _filesystem_kv_compact(int32_t size) {
+    // only whole records; a torn one at the end is dropped along with the superseded ones.
+    size -= size % FILESYSTEM_KV_RECORD_SIZE;
+    uint8_t *records = malloc(size);
+    if (records == NULL) return false;
+
+    int err = lfs_file_open(&eeprom_filesystem, &file, FILESYSTEM_KV_FILENAME, LFS_O_RDONLY);
+    if (err >= 0) {
+        lfs_ssize_t bytes_read = lfs_file_read(&eeprom_filesystem, &file, records, size);
+        lfs_file_close(&eeprom_filesystem, &file);
+        // a short read would leave part of the buffer uninitialized; keep the old log rather than compact that.
+        if (bytes_read != size) err = bytes_read < 0 ? bytes_read : LFS_ERR_IO;
+    }
+    if (err < 0) {
+        free(records);
+        return false;
+    }
+
+    // keep each record that isn't superseded by a later one, in place.
+    int32_t live_size = 0;
+    for (int32_t i = 0; i < size; i += FILESYSTEM_KV_RECORD_SIZE) {
+        bool superseded = false;
+        for (int32_t j = i + FILESYSTEM_KV_RECORD_SIZE; j < size; j += FILESYSTEM_KV_RECORD_SIZE) {
+            if (_filesystem_kv_key(records + j) == _filesystem_kv_key(records + i)) {
+                superseded = true;
+                break;
+            }
+        }
+        if (!superseded) {
+            memmove(records + live_size, records + i, FILESYSTEM_KV_RECORD_SIZE);
+            live_size += FILESYSTEM_KV_RECORD_SIZE;
+        }
+    }
+
+    // write the compacted log alongside the old one, then swap them in one go, so a reset can't lose anything.
+    err = lfs_file_open(&eeprom_filesystem, &file, FILESYSTEM_KV_TEMP_FILENAME, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC);
+    if (err >= 0) {
+        err = lfs_file_write(&eeprom_filesystem, &file, records, live_size);
+        int close_err = lfs_file_close(&eeprom_filesystem, &file);
+        if (err >= 0) err = close_err;
+    }
+    if (err >= 0) err = lfs_rename(&eeprom_filesystem, FILESYSTEM_KV_TEMP_FILENAME, FILESYSTEM_KV_FILENAME);
+    free(records);
+
+    // if most of the log is live, let it grow further before the next compaction.
+    _kv_compact_size = NVMCTRL_ROW_SIZE;
+    while (_kv_compact_size < live_size * 2) _kv_compact_size += NVMCTRL_ROW_SIZE;
+
+    return err >= 0;
+}
+
+bool filesystem_kv_put_many(const uint16_t *keys, const uint32_t *values, uint8_t count) {
+    uint8_t records[FILESYSTEM_KV_RECORD_SIZE * 8];
+    uint8_t num_records = 0;
+    // one bit per key, set if the last record with that key already has the value we'd write.
+    uint8_t unchanged[32] = {0};
+    uint8_t num_changed = count;
+
+    // one pass over the log for all of the keys, rather than a filesystem_kv_get for each.
+    lfs_file_t kv_file;
+    int err = lfs_file_open(&eeprom_filesystem, &kv_file, FILESYSTEM_KV_FILENAME, LFS_O_RDONLY);
+    if (err >= 0) {
+        lfs_ssize_t bytes_read;
+        while ((bytes_read = lfs_file_read(&eeprom_filesystem, &kv_file, records, sizeof(records))) > 0) {
+            for (lfs_ssize_t i = 0; i + FILESYSTEM_KV_RECORD_SIZE <= bytes_read; i += FILESYSTEM_KV_RECORD_SIZE) {
+                uint16_t key = _filesystem_kv_key(records + i);
+                for (uint8_t k = 0; k < count; k++) {
+                    if (keys[k] != key) continue;
+                    if (_filesystem_kv_value(records + i) == values[k]) unchanged[k / 8] |= 1 << (k % 8);
+                    else unchanged[k / 8] &= ~(1 << (k % 8));
+                }
+            }
+        }
+        lfs_file_close(&eeprom_filesystem, &kv_file);
+        for (uint8_t k = 0; k < count; k++) {
+            if (unchanged[k / 8] & (1 << (k % 8))) num_changed--;
+        }
+    }
+
+    // nothing changed, so nothing to write.
+    if (num_changed == 0) return true;
+
+    if (filesystem_get_free_space() <= 256) {
+        printf("No free space!\n");
+        return false;
+    }
+
+    _filesystem_close_read_line_reader();
+    err = lfs_file_open(&eeprom_filesystem, &file, FILESYSTEM_KV_FILENAME, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND);
+    if (err < 0) return false;
+
+    // appending after a torn record would shift every record after it, so drop the partial one first.
+    lfs_soff_t log_size = lfs_file_size(&eeprom_filesystem, &file);
+    if (log_size % FILESYSTEM_KV_RECORD_SIZE) err = lfs_file_truncate(&eeprom_filesystem, &file, log_size - log_size % FILESYSTEM_KV_RECORD_SIZE);
+
+    for (uint8_t k = 0; k < count && err >= 0; k++) {
+        if (unchanged[k / 8] & (1 << (k % 8))) continue;
+
+        _filesystem_kv_pack(records + num_records * FILESYSTEM_KV_RECORD_SIZE, keys[k], values[k]);
+        if (++num_records * FILESYSTEM_KV_RECORD_SIZE == sizeof(records)) {
+            err = lfs_file_write(&eeprom_filesystem, &file, records, sizeof(records));
+            num_records = 0;
+        }
+    }
+
+    if (num_records && err >= 0) err = lfs_file_write(&eeprom_filesystem, &file, records, num_records * FILESYSTEM_KV_RECORD_SIZE);
+    int32_t size = lfs_file_size(&eeprom_filesystem, &file);
+    // everything we appended is committed at once, here.
+    if (lfs_file_close(&eeprom_filesystem, &file) < 0 || err < 0) return false;
+
+    if (size >= _kv_compact_size) return _filesystem_kv_compact(size);
+
+    return true;
+}
+
+bool filesystem_kv_put(uint16_t key, uint32_t value) {
+    return filesystem_kv_put_many(&key, &value, 1);
+}
+
+bool filesystem_kv_import_file(uint16_t key, char *filename) {
+    uint32_t value = 0;
+
+    if (filesystem_get_file_size(filename) != sizeof(value)) return false;
+    if (!filesystem_read_file(filename, (char *)&value, sizeof(value))) return false;
+    if (!filesystem_kv_put(key, value)) return false;
+
+    return lfs_remove(&eeprom_filesystem, filename) == LFS_ERR_OK;
+}
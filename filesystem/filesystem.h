@@ -50,6 +50,14 @@ bool filesystem_file_exists(char *filename);
   */
 bool filesystem_rm(char *filename);
 
+/** @brief Renames a file, replacing any file that already has the new name.
+  * @details This happens in a single commit, so after a reset there is either the old file or the new one.
+  * @param old_filename the file you wish to rename
+  * @param new_filename its new name
+  * @return true if the file was renamed successfully; false otherwise
+  */
+bool filesystem_rename(char *old_filename, char *new_filename);
+
 /** @brief Gets the size of a file on the filesystem.
   * @param filename the file whose size you wish to determine
   * @return the file's size in bytes, or -1 if the file does not exist.
@@ -77,6 +85,9 @@ bool filesystem_read_file(char *filename, char *buf, int32_t length);
   *               to reflect the offset of the next line.
   * @param length The maximum number of bytes to read
   * @return true if the read was successful; false otherwise
+  * @note The file stays open between calls, so reading a file line by line doesn't re-read it from the
+  *       start each time. Past the last line, you get an empty buffer. If you only need to scan a file
+  *       once, a filesystem_line_reader_t avoids copying each line.
   */
 bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t length);
 
@@ -96,9 +107,142 @@ bool filesystem_write_file(char *filename, char *text, int32_t length);
   */
 bool filesystem_append_file(char *filename, char *text, int32_t length);
 
+/** @brief The number of files that can be open with filesystem_open at the same time. Each one costs about 150 bytes of RAM.
+  */
+#ifndef FILESYSTEM_MAX_OPEN_FILES
+#define FILESYSTEM_MAX_OPEN_FILES 2
+#endif
+
+typedef int8_t filesystem_handle_t;
+
+typedef enum {
+    FILESYSTEM_OPEN_READ = 0,
+    FILESYSTEM_OPEN_APPEND,
+    FILESYSTEM_OPEN_WRITE,
+} filesystem_open_mode_t;
+
+/** @brief Opens a file and keeps it open, for reading it line by line or appending to it piece by piece.
+  * @details The functions above open, seek and close the file every time you call them. If you're scanning
+  *          through a file or writing a log, open it once with this function instead; the file keeps its own
+  *          cursor and cache until you call filesystem_close.
+  * @param filename the file you wish to open
+  * @param mode FILESYSTEM_OPEN_READ to read from the start of the file, FILESYSTEM_OPEN_APPEND to add to the
+  *             end of it (creating it if need be), or FILESYSTEM_OPEN_WRITE to replace its contents with whatever
+  *             you append.
+  * @return a handle for the other functions below, or -1 if the file couldn't be opened, or too many files are
+  *         open already.
+  */
+filesystem_handle_t filesystem_open(char *filename, filesystem_open_mode_t mode);
+
+/** @brief Reads the next line from a file opened for reading.
+  * @param handle the handle from filesystem_open
+  * @param buf A buffer of length bytes; the line will be read into it without its newline, and null-terminated.
+  *            If the line is longer than length - 1 bytes, you get the start of it, and the rest is skipped.
+  * @param length The size of buf
+  * @return the length of the line, which may be 0 for an empty line, or -1 at the end of the file.
+  */
+int32_t filesystem_readline(filesystem_handle_t handle, char *buf, int32_t length);
+
+/** @brief Reads the next chunk of a file opened for reading, wherever the lines fall.
+  * @param handle the handle from filesystem_open
+  * @param buf A buffer of at least length bytes. It is not null-terminated.
+  * @param length The most bytes to read
+  * @return the number of bytes read, 0 at the end of the file, or -1 on error.
+  */
+int32_t filesystem_read(filesystem_handle_t handle, char *buf, int32_t length);
+
+/** @brief Appends to a file opened for appending or writing. The data may not hit the disk until filesystem_close.
+  * @param handle the handle from filesystem_open
+  * @param text The contents to write
+  * @param length The number of bytes to write
+  * @return true if the write was successful; false otherwise
+  */
+bool filesystem_append(filesystem_handle_t handle, char *text, int32_t length);
+
+/// @brief Returns the position of a file's cursor, i.e. the offset that the next read will start from.
+int32_t filesystem_tell(filesystem_handle_t handle);
+
+/// @brief Moves a file's cursor to the given offset from the start of the file.
+bool filesystem_seek(filesystem_handle_t handle, int32_t offset);
+
+/** @brief Closes a file opened with filesystem_open, writing out anything appended to it.
+  * @return true if the file was closed (and written) successfully; false otherwise
+  */
+bool filesystem_close(filesystem_handle_t handle);
+
+typedef struct {
+    filesystem_handle_t handle;
+    char *buffer;
+    int32_t size;
+    int32_t start;      // the first byte in buffer that hasn't been returned yet
+    int32_t end;        // the end of the data in buffer
+    int32_t offset;     // the offset in the file of buffer[start]
+    bool at_end;
+} filesystem_line_reader_t;
+
+/** @brief Opens a file for reading line by line with filesystem_line_reader_next, in a single pass.
+  * @param reader the reader to set up
+  * @param filename the file you wish to read
+  * @param buffer A buffer the reader works in; lines are returned from it rather than copied out. One or two
+  *               multiples of littlefs' cache size (64 bytes) plus one makes for the fewest flash reads.
+  * @param size The size of buffer. Lines longer than size - 1 bytes come back in pieces.
+  * @return true if the file was opened; false otherwise. The reader uses one of the filesystem_open handles.
+  */
+bool filesystem_line_reader_open(filesystem_line_reader_t *reader, char *filename, char *buffer, int32_t size);
+
+/** @brief Returns the next line from the file, without its newline.
+  * @param reader the reader from filesystem_line_reader_open
+  * @param length if not NULL, receives the length of the line
+  * @return a null-terminated line inside the reader's buffer, valid until the next call, or NULL at the end of
+  *         the file. You may modify the line in place.
+  */
+char *filesystem_line_reader_next(filesystem_line_reader_t *reader, int32_t *length);
+
+/// @brief Returns the offset in the file of the next line filesystem_line_reader_next will return.
+int32_t filesystem_line_reader_tell(filesystem_line_reader_t *reader);
+
+/// @brief Moves the reader to the given offset from the start of the file, discarding what it has buffered.
+bool filesystem_line_reader_seek(filesystem_line_reader_t *reader, int32_t offset);
+
+/// @brief Closes the reader's file.
+void filesystem_line_reader_close(filesystem_line_reader_t *reader);
+
+/** @brief Looks up a value in the key-value store.
+  * @details The key-value store keeps small settings as fixed-size records in a single log file, so that dozens
+  *          of them fit in a block or two, rather than taking up a file (and a block) each. You probably want
+  *          movement_kv_get and movement_kv_put, which are the same thing.
+  * @param key the key you stored the value under
+  * @param value receives the value, if there is one
+  * @return true if the key has a value; false otherwise
+  */
+bool filesystem_kv_get(uint16_t key, uint32_t *value);
+
+/** @brief Stores a value in the key-value store. If the key already has this value, nothing is written.
+  * @param key the key to store the value under
+  * @param value the value
+  * @return true if the value was stored successfully; false otherwise
+  */
+bool filesystem_kv_put(uint16_t key, uint32_t value);
+
+/** @brief Stores several values in the key-value store, in a single commit.
+  * @param keys the keys to store the values under
+  * @param values the values, in the same order as keys
+  * @param count the number of keys and values
+  * @return true if the values were stored successfully; false otherwise
+  */
+bool filesystem_kv_put_many(const uint16_t *keys, const uint32_t *values, uint8_t count);
+
+/** @brief Moves a value from a four-byte file into the key-value store, and removes the file.
+  * @details This is for upgrading from the old way of storing settings, a file per value.
+  * @return true if there was such a file and it was imported; false otherwise
+  */
+bool filesystem_kv_import_file(uint16_t key, char *filename);
+
 int filesystem_cmd_ls(int argc, char *argv[]);
 int filesystem_cmd_cat(int argc, char *argv[]);
 int filesystem_cmd_b64encode(int argc, char *argv[]);
+int filesystem_cmd_get(int argc, char *argv[]);
+int filesystem_cmd_put(int argc, char *argv[]);
 int filesystem_cmd_df(int argc, char *argv[]);
 int filesystem_cmd_rm(int argc, char *argv[]);
 int filesystem_cmd_format(int argc, char *argv[]);
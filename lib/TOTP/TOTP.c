@@ -1,21 +1,38 @@
 #include "TOTP.h"
-#include "sha1.h"
-#include "sha256.h"
-#include "sha512.h"
+#include <string.h>
 #include <stdio.h>
 
-uint8_t* _hmacKey;
-uint8_t _keyLength;
+static totp_hmac_state _state;
 uint8_t _timeZoneOffset;
-uint32_t _timeStep;
-hmac_alg _algorithm;
+
+// Init a state with the private key, its length, the timeStep duration and the algorithm that should be used
+void TOTPInitState(totp_hmac_state* state, const uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm) {
+    memset(state, 0, sizeof(totp_hmac_state));
+    state->timeStep = timeStep;
+    state->algorithm = algorithm;
+
+    switch(algorithm){
+        case SHA1:
+            HMAC_SHA1_precompute(hmacKey, keyLength, &state->midstate.sha1);
+            break;
+        case SHA224:
+            HMAC_SHA256_precompute(hmacKey, keyLength, &state->midstate.sha256, 1);
+            break;
+        case SHA256:
+            HMAC_SHA256_precompute(hmacKey, keyLength, &state->midstate.sha256, 0);
+            break;
+        case SHA384:
+            HMAC_SHA512_precompute(hmacKey, keyLength, &state->midstate.sha512, 1);
+            break;
+        case SHA512:
+            HMAC_SHA512_precompute(hmacKey, keyLength, &state->midstate.sha512, 0);
+            break;
+    }
+}
 
 // Init the library with the private key, its length, the timeStep duration and the algorithm that should be used
 void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm) {
-    _hmacKey = hmacKey;
-    _keyLength = keyLength;
-    _timeStep = timeStep;
-    _algorithm = algorithm;
+    TOTPInitState(&_state, hmacKey, keyLength, timeStep, algorithm);
 }
 
 void setTimezone(uint8_t timezone){
@@ -30,8 +47,7 @@ static uint32_t TimeStruct2Timestamp(struct tm time){
 
 // Generate a code, using the timestamp provided
 uint32_t getCodeFromTimestamp(uint32_t timeStamp) {
-    uint32_t steps = timeStamp / _timeStep;
-    return getCodeFromSteps(steps);
+    return getCodeFromTimestampWithState(&_state, timeStamp);
 }
 
 // Generate a code, using the timestamp provided
@@ -41,6 +57,37 @@ uint32_t getCodeFromTimeStruct(struct tm time) {
 
 // Generate a code, using the number of steps provided
 uint32_t getCodeFromSteps(uint32_t steps) {
+    return getCodeFromStepsWithState(&_state, steps);
+}
+
+// Generate a code for a state, using the timestamp provided
+uint32_t getCodeFromTimestampWithState(const totp_hmac_state* state, uint32_t timeStamp) {
+    uint32_t steps = timeStamp / state->timeStep;
+    return getCodeFromStepsWithState(state, steps);
+}
+
+// Bring a cached code up to date for the timestamp provided, and return it
+uint32_t updateCachedCode(const totp_hmac_state* state, totp_cached_code* cache, uint32_t timeStamp) {
+    uint32_t steps = timeStamp / state->timeStep;
+
+    if (cache->valid && cache->steps == steps) {
+        return cache->code;
+    }
+
+    if (cache->valid && cache->steps + 1 == steps) {
+        cache->code = cache->nextCode;
+    } else {
+        cache->code = getCodeFromStepsWithState(state, steps);
+    }
+    cache->nextCode = getCodeFromStepsWithState(state, steps + 1);
+    cache->steps = steps;
+    cache->valid = true;
+
+    return cache->code;
+}
+
+// Generate a code for a state, using the number of steps provided
+uint32_t getCodeFromStepsWithState(const totp_hmac_state* state, uint32_t steps) {
     // STEP 0, map the number of steps in a 8-bytes array (counter value)
     uint8_t _byteArray[8];
     _byteArray[0] = 0x00;
@@ -52,18 +99,46 @@ uint32_t getCodeFromSteps(uint32_t steps) {
     _byteArray[6] = (uint8_t)((steps >> 8) & 0XFF);
     _byteArray[7] = (uint8_t)((steps & 0XFF));
 
-    switch(_algorithm){
+    // STEP 1, get the HMAC hash from counter and key
+    uint8_t hash[SHA512_DIGEST_LENGTH];
+    uint8_t digest_length;
+    switch(state->algorithm){
         case SHA1:
-            return(TOTP_HMAC_SHA1(_hmacKey, _keyLength, _byteArray, 8));
+            HMAC_SHA1_from_midstate(&state->midstate.sha1, _byteArray, 8, hash);
+            digest_length = SHA1_DIGEST_LENGTH;
+            break;
         case SHA224:
-            return(TOTP_HMAC_SHA256(_hmacKey, _keyLength, _byteArray, 8, 1));
+            HMAC_SHA256_from_midstate(&state->midstate.sha256, _byteArray, 8, hash);
+            digest_length = SHA224_DIGEST_LENGTH;
+            break;
         case SHA256:
-            return(TOTP_HMAC_SHA256(_hmacKey, _keyLength, _byteArray, 8, 0));
+            HMAC_SHA256_from_midstate(&state->midstate.sha256, _byteArray, 8, hash);
+            digest_length = SHA256_DIGEST_LENGTH;
+            break;
         case SHA384:
-            return(TOTP_HMAC_SHA512(_hmacKey, _keyLength, _byteArray, 8, 1));
+            HMAC_SHA512_from_midstate(&state->midstate.sha512, _byteArray, 8, hash);
+            digest_length = SHA384_DIGEST_LENGTH;
+            break;
         case SHA512:
-            return(TOTP_HMAC_SHA512(_hmacKey, _keyLength, _byteArray, 8, 0));
+            HMAC_SHA512_from_midstate(&state->midstate.sha512, _byteArray, 8, hash);
+            digest_length = SHA512_DIGEST_LENGTH;
+            break;
         default:
             return(0);
     }
+
+    // STEP 2, apply dynamic truncation to obtain a 4-bytes string
+    uint32_t truncated_hash = 0;
+    uint8_t _offset = hash[digest_length - 1] & 0xF;
+    uint8_t j;
+    for (j = 0; j < 4; ++j) {
+        truncated_hash <<= 8;
+        truncated_hash  |= hash[_offset + j];
+    }
+
+    // STEP 3, compute the OTP value
+    truncated_hash &= 0x7FFFFFFF;
+    truncated_hash %= 1000000;
+
+    return truncated_hash;
 }
@@ -2,7 +2,11 @@
 #define TOTP_H_
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include "time.h"
+#include "sha1.h"
+#include "sha256.h"
+#include "sha512.h"
 
 typedef enum __attribute__ ((__packed__)) {
     SHA1,
@@ -12,6 +16,35 @@ typedef enum __attribute__ ((__packed__)) {
     SHA512
 } hmac_alg;
 
+// Everything needed to generate codes for one key. The key itself isn't kept, only its HMAC midstates, so each new
+// code costs two hash compressions instead of four. Fill it in once with TOTPInitState.
+typedef struct {
+    union {
+        hmac_sha1_midstate sha1;
+        hmac_sha256_midstate sha256;
+        hmac_sha512_midstate sha512;
+    } midstate;
+    uint32_t timeStep;
+    hmac_alg algorithm;
+} totp_hmac_state;
+
+void TOTPInitState(totp_hmac_state* state, const uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm);
+uint32_t getCodeFromTimestampWithState(const totp_hmac_state* state, uint32_t timeStamp);
+uint32_t getCodeFromStepsWithState(const totp_hmac_state* state, uint32_t steps);
+
+// A key's current code and the one after it. Keep one per key and bring them all up to date together, e.g. once a
+// second: most calls do nothing, and at a step boundary the current code is already there, so only the next one
+// costs any hashing. Looking a code up afterwards is free. Zero it to start over, e.g. when the key changes.
+typedef struct {
+    uint32_t steps;
+    uint32_t code;
+    uint32_t nextCode;
+    bool valid;
+} totp_cached_code;
+
+uint32_t updateCachedCode(const totp_hmac_state* state, totp_cached_code* cache, uint32_t timeStamp);
+
+// The original interface, which keeps one key's state inside the library.
 void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm);
 void setTimezone(uint8_t timezone);
 uint32_t getCodeFromTimestamp(uint32_t timeStamp);
@@ -125,6 +125,38 @@ void mbedtls_sha1_process( mbedtls_sha1_context *ctx, const unsigned char data[S
     D = ctx->state[3];
     E = ctx->state[4];
 
+#if defined(MBEDTLS_SHA1_SMALLER)
+    {
+        uint32_t f, k, x;
+        int i;
+
+        for( i = 0; i < 80; i++ )
+        {
+            x = ( i < 16 ) ? W[i] : R(i);
+
+            if( i < 20 )
+            {
+                f = D ^ ( B & ( C ^ D ) ); k = 0x5A827999;
+            }
+            else if( i < 40 )
+            {
+                f = B ^ C ^ D; k = 0x6ED9EBA1;
+            }
+            else if( i < 60 )
+            {
+                f = ( B & C ) | ( D & ( B | C ) ); k = 0x8F1BBCDC;
+            }
+            else
+            {
+                f = B ^ C ^ D; k = 0xCA62C1D6;
+            }
+
+            temp = S(A,5) + f + E + k + x;
+            E = D; D = C; C = S(B,30); B = A; A = temp;
+        }
+    }
+#else /* MBEDTLS_SHA1_SMALLER */
+
 #define F(x,y,z) (z ^ (x & (y ^ z)))
 #define K 0x5A827999
 
@@ -232,6 +264,7 @@ void mbedtls_sha1_process( mbedtls_sha1_context *ctx, const unsigned char data[S
 
 #undef K
 #undef F
+#endif /* MBEDTLS_SHA1_SMALLER */
 
     ctx->state[0] += A;
     ctx->state[1] += B;
@@ -332,46 +365,84 @@ void mbedtls_sha1( const unsigned char *input, size_t ilen, unsigned char output
 }
 
 /*
-* Compute HMAC_SHA1 using key, key length, text to hash, size of the text, and output buffer
+* Compute the HMAC_SHA1 midstates for a key: the state after hashing the key XORd with ipad, and with opad
 */
-void HMAC_SHA1(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t out[SHA1_DIGEST_LENGTH]){
+void HMAC_SHA1_precompute(const uint8_t* key, size_t key_length, hmac_sha1_midstate *midstate){
 
   uint8_t i;
-  uint8_t k_ipad[SHA1_BLOCK_LENGTH]; /* inner padding - key XORd with ipad */
-  uint8_t k_opad[SHA1_BLOCK_LENGTH]; /* outer padding - key XORd with opad */
-  uint8_t buffer[SHA1_BLOCK_LENGTH + SHA1_DIGEST_LENGTH];
+  uint8_t k_pad[SHA1_BLOCK_LENGTH]; /* key XORd with ipad, then opad */
+  mbedtls_sha1_context ctx;
 
-  /* start out by storing key in pads */
-  memset(k_ipad, 0, sizeof(k_ipad));
-  memset(k_opad, 0, sizeof(k_opad));
+  /* start out by storing key in the pad */
+  memset(k_pad, 0, sizeof(k_pad));
 
   if (key_length <= SHA1_BLOCK_LENGTH) {
-      memcpy(k_ipad, key, key_length);
-      memcpy(k_opad, key, key_length);
+      memcpy(k_pad, key, key_length);
   }
 
   else {
-      mbedtls_sha1(key, key_length, k_ipad);
-      memcpy(k_opad, k_ipad, SHA1_BLOCK_LENGTH);
+      mbedtls_sha1(key, key_length, k_pad);
+  }
+
+  // hash the inner pad
+  for (i = 0; i < SHA1_BLOCK_LENGTH; i++) {
+      k_pad[i] ^= HMAC_IPAD;
   }
+  mbedtls_sha1_starts(&ctx);
+  mbedtls_sha1_process(&ctx, k_pad);
+  memcpy(midstate->inner, ctx.state, sizeof(midstate->inner));
 
-  /* XOR key with ipad and opad values */
+  // and the outer pad
   for (i = 0; i < SHA1_BLOCK_LENGTH; i++) {
-      k_ipad[i] ^= HMAC_IPAD;
-      k_opad[i] ^= HMAC_OPAD;
+      k_pad[i] ^= HMAC_IPAD ^ HMAC_OPAD;
   }
-  
+  mbedtls_sha1_starts(&ctx);
+  mbedtls_sha1_process(&ctx, k_pad);
+  memcpy(midstate->outer, ctx.state, sizeof(midstate->outer));
+
+  mbedtls_zeroize(k_pad, sizeof(k_pad));
+  mbedtls_sha1_free(&ctx);
+}
+
+/*
+* Pick up a hash where a midstate left off, with one block already processed
+*/
+static void hmac_sha1_resume(mbedtls_sha1_context *ctx, const uint32_t state[5]){
+  memcpy(ctx->state, state, sizeof(ctx->state));
+  ctx->total[0] = SHA1_BLOCK_LENGTH;
+  ctx->total[1] = 0;
+}
+
+/*
+* Compute HMAC_SHA1 using a key's midstates, text to hash, size of the text, and output buffer
+*/
+void HMAC_SHA1_from_midstate(const hmac_sha1_midstate *midstate, const uint8_t *in, size_t n, uint8_t out[SHA1_DIGEST_LENGTH]){
+
+  mbedtls_sha1_context ctx;
+
   // perform inner SHA1
-  memcpy(buffer, k_ipad, SHA1_BLOCK_LENGTH);
-  memcpy(buffer + SHA1_BLOCK_LENGTH, in, n);
-  mbedtls_sha1(buffer, SHA1_BLOCK_LENGTH + n, out);
-  
-  memset(buffer, 0, SHA1_BLOCK_LENGTH + n);
+  hmac_sha1_resume(&ctx, midstate->inner);
+  mbedtls_sha1_update(&ctx, in, n);
+  mbedtls_sha1_finish(&ctx, out);
 
   // perform outer SHA1
-  memcpy(buffer, k_opad, SHA1_BLOCK_LENGTH);
-  memcpy(buffer + SHA1_BLOCK_LENGTH, out, SHA1_DIGEST_LENGTH);
-  mbedtls_sha1(buffer, SHA1_BLOCK_LENGTH + SHA1_DIGEST_LENGTH, out);
+  hmac_sha1_resume(&ctx, midstate->outer);
+  mbedtls_sha1_update(&ctx, out, SHA1_DIGEST_LENGTH);
+  mbedtls_sha1_finish(&ctx, out);
+
+  mbedtls_sha1_free(&ctx);
+}
+
+/*
+* Compute HMAC_SHA1 using key, key length, text to hash, size of the text, and output buffer
+*/
+void HMAC_SHA1(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t out[SHA1_DIGEST_LENGTH]){
+
+  hmac_sha1_midstate midstate;
+
+  HMAC_SHA1_precompute(key, key_length, &midstate);
+  HMAC_SHA1_from_midstate(&midstate, in, n, out);
+  mbedtls_zeroize(&midstate, sizeof(midstate));
 }
 /*
 * Compute TOTP_HMAC_SHA1 using key, key length, text to hash, size of the text
@@ -92,6 +92,38 @@ void mbedtls_sha1_process( mbedtls_sha1_context *ctx, const unsigned char data[S
  */
 void mbedtls_sha1( const unsigned char *input, size_t ilen, unsigned char output[SHA1_DIGEST_LENGTH] );
 void HMAC_SHA1(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t out[SHA1_DIGEST_LENGTH]);
+
+/**
+ * \brief          HMAC-SHA-1 key midstates: the hash state after compressing
+ *                 the key XORd with ipad, and with opad. Computing them once
+ *                 per key saves two of the four compressions in every HMAC
+ *                 of a short message.
+ */
+typedef struct
+{
+    uint32_t inner[5];          /*!< state after the ipad block */
+    uint32_t outer[5];          /*!< state after the opad block */
+}
+hmac_sha1_midstate;
+
+/**
+ * \brief          Compute the HMAC-SHA-1 midstates for a key
+ *
+ * \param key      the HMAC key
+ * \param key_length length of the key
+ * \param midstate receives the midstates
+ */
+void HMAC_SHA1_precompute(const uint8_t* key, size_t key_length, hmac_sha1_midstate *midstate);
+
+/**
+ * \brief          Output = HMAC-SHA-1( key, input buffer ), from the key's midstates
+ *
+ * \param midstate the key's midstates, from HMAC_SHA1_precompute
+ * \param in       buffer holding the data
+ * \param n        length of the input data
+ * \param out      HMAC-SHA-1 result
+ */
+void HMAC_SHA1_from_midstate(const hmac_sha1_midstate *midstate, const uint8_t *in, size_t n, uint8_t out[SHA1_DIGEST_LENGTH]);
 uint32_t TOTP_HMAC_SHA1(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n);
 
 
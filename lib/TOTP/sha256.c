@@ -166,6 +166,22 @@ void mbedtls_sha256_process( mbedtls_sha256_context *ctx, const unsigned char da
     for( i = 0; i < 8; i++ )
         A[i] = ctx->state[i];
 
+#if defined(MBEDTLS_SHA256_SMALLER)
+    for( i = 0; i < 64; i++ )
+    {
+        if( i < 16 )
+        {
+            GET_UINT32_BE( W[i], data, 4 * i );
+        }
+        else
+            R( i );
+
+        P( A[0], A[1], A[2], A[3], A[4], A[5], A[6], A[7], W[i], K[i] );
+
+        temp1 = A[7]; A[7] = A[6]; A[6] = A[5]; A[5] = A[4]; A[4] = A[3];
+        A[3] = A[2]; A[2] = A[1]; A[1] = A[0]; A[0] = temp1;
+    }
+#else /* MBEDTLS_SHA256_SMALLER */
     for( i = 0; i < 16; i++ )
         GET_UINT32_BE( W[i], data, 4 * i );
 
@@ -192,6 +208,7 @@ void mbedtls_sha256_process( mbedtls_sha256_context *ctx, const unsigned char da
         P( A[2], A[3], A[4], A[5], A[6], A[7], A[0], A[1], R(i+6), K[i+6] );
         P( A[1], A[2], A[3], A[4], A[5], A[6], A[7], A[0], R(i+7), K[i+7] );
     }
+#endif /* MBEDTLS_SHA256_SMALLER */
 
     for( i = 0; i < 8; i++ )
         ctx->state[i] += A[i];
@@ -296,50 +313,90 @@ void mbedtls_sha256( const unsigned char *input, size_t ilen,
 }
 
 /*
-* Compute HMAC_SHA224/256 using key, key length, text to hash, size of the text, output buffer and a switch for SHA224
+* Compute the HMAC_SHA224/256 midstates for a key: the state after hashing the key XORd with ipad, and with opad
 */
-void HMAC_SHA256(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t* out, int is224){
-  int digest_length = SHA256_DIGEST_LENGTH;
-  if (is224 == 1) {
-    digest_length = SHA224_DIGEST_LENGTH;
-  }
-  
+void HMAC_SHA256_precompute(const uint8_t* key, size_t key_length, hmac_sha256_midstate *midstate, int is224){
+
   uint8_t i;
-  uint8_t k_ipad[SHA256_BLOCK_LENGTH]; /* inner padding - key XORd with ipad */
-  uint8_t k_opad[SHA256_BLOCK_LENGTH]; /* outer padding - key XORd with opad */
-  uint8_t buffer[SHA256_BLOCK_LENGTH + digest_length];
+  uint8_t k_pad[SHA256_BLOCK_LENGTH]; /* key XORd with ipad, then opad */
+  mbedtls_sha256_context ctx;
 
-  /* start out by storing key in pads */
-  memset(k_ipad, 0, sizeof(k_ipad));
-  memset(k_opad, 0, sizeof(k_opad));
+  /* start out by storing key in the pad */
+  memset(k_pad, 0, sizeof(k_pad));
 
   if (key_length <= SHA256_BLOCK_LENGTH) {
-      memcpy(k_ipad, key, key_length);
-      memcpy(k_opad, key, key_length);
+      memcpy(k_pad, key, key_length);
   }
 
   else {
-      mbedtls_sha256(key, key_length, k_ipad, is224);
-      memcpy(k_opad, k_ipad, SHA256_BLOCK_LENGTH);
+      mbedtls_sha256(key, key_length, k_pad, is224);
   }
 
-  /* XOR key with ipad and opad values */
+  // hash the inner pad
   for (i = 0; i < SHA256_BLOCK_LENGTH; i++) {
-      k_ipad[i] ^= HMAC_IPAD;
-      k_opad[i] ^= HMAC_OPAD;
+      k_pad[i] ^= HMAC_IPAD;
+  }
+  mbedtls_sha256_starts(&ctx, is224);
+  mbedtls_sha256_process(&ctx, k_pad);
+  memcpy(midstate->inner, ctx.state, sizeof(midstate->inner));
+
+  // and the outer pad
+  for (i = 0; i < SHA256_BLOCK_LENGTH; i++) {
+      k_pad[i] ^= HMAC_IPAD ^ HMAC_OPAD;
+  }
+  mbedtls_sha256_starts(&ctx, is224);
+  mbedtls_sha256_process(&ctx, k_pad);
+  memcpy(midstate->outer, ctx.state, sizeof(midstate->outer));
+  midstate->is224 = is224;
+
+  mbedtls_zeroize(k_pad, sizeof(k_pad));
+  mbedtls_sha256_free(&ctx);
+}
+
+/*
+* Pick up a hash where a midstate left off, with one block already processed
+*/
+static void hmac_sha256_resume(mbedtls_sha256_context *ctx, const uint32_t state[8], int is224){
+  memcpy(ctx->state, state, sizeof(ctx->state));
+  ctx->total[0] = SHA256_BLOCK_LENGTH;
+  ctx->total[1] = 0;
+  ctx->is224 = is224;
+}
+
+/*
+* Compute HMAC_SHA224/256 using a key's midstates, text to hash, size of the text and output buffer
+*/
+void HMAC_SHA256_from_midstate(const hmac_sha256_midstate *midstate, const uint8_t *in, size_t n, uint8_t* out){
+  int digest_length = SHA256_DIGEST_LENGTH;
+  if (midstate->is224 == 1) {
+    digest_length = SHA224_DIGEST_LENGTH;
   }
-  
+
+  mbedtls_sha256_context ctx;
+
   // perform inner SHA256
-  memcpy(buffer, k_ipad, SHA256_BLOCK_LENGTH);
-  memcpy(buffer + SHA256_BLOCK_LENGTH, in, n);
-  mbedtls_sha256(buffer, SHA256_BLOCK_LENGTH + n, out, is224);
-  
-  memset(buffer, 0, SHA256_BLOCK_LENGTH + n);
+  hmac_sha256_resume(&ctx, midstate->inner, midstate->is224);
+  mbedtls_sha256_update(&ctx, in, n);
+  mbedtls_sha256_finish(&ctx, out);
 
   // perform outer SHA256
-  memcpy(buffer, k_opad, SHA256_BLOCK_LENGTH);
-  memcpy(buffer + SHA256_BLOCK_LENGTH, out, digest_length);
-  mbedtls_sha256(buffer, SHA256_BLOCK_LENGTH + digest_length, out, is224);
+  hmac_sha256_resume(&ctx, midstate->outer, midstate->is224);
+  mbedtls_sha256_update(&ctx, out, digest_length);
+  mbedtls_sha256_finish(&ctx, out);
+
+  mbedtls_sha256_free(&ctx);
+}
+
+/*
+* Compute HMAC_SHA224/256 using key, key length, text to hash, size of the text, output buffer and a switch for SHA224
+*/
+void HMAC_SHA256(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t* out, int is224){
+
+  hmac_sha256_midstate midstate;
+
+  HMAC_SHA256_precompute(key, key_length, &midstate, is224);
+  HMAC_SHA256_from_midstate(&midstate, in, n, out);
+  mbedtls_zeroize(&midstate, sizeof(midstate));
 }
 
 /*
@@ -107,6 +107,40 @@ void mbedtls_sha256_process( mbedtls_sha256_context *ctx, const unsigned char da
 void mbedtls_sha256( const unsigned char *input, size_t ilen,
            unsigned char* output, int is224 );
 void HMAC_SHA256(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t* out, int is224);
+
+/**
+ * \brief          HMAC-SHA-224/256 key midstates: the hash state after
+ *                 compressing the key XORd with ipad, and with opad. Computing
+ *                 them once per key saves two of the four compressions in
+ *                 every HMAC of a short message.
+ */
+typedef struct
+{
+    uint32_t inner[8];          /*!< state after the ipad block */
+    uint32_t outer[8];          /*!< state after the opad block */
+    int is224;                  /*!< 0 => SHA-256, else SHA-224 */
+}
+hmac_sha256_midstate;
+
+/**
+ * \brief          Compute the HMAC-SHA-224/256 midstates for a key
+ *
+ * \param key      the HMAC key
+ * \param key_length length of the key
+ * \param midstate receives the midstates
+ * \param is224    0 = use SHA256, 1 = use SHA224
+ */
+void HMAC_SHA256_precompute(const uint8_t* key, size_t key_length, hmac_sha256_midstate *midstate, int is224);
+
+/**
+ * \brief          Output = HMAC-SHA-224/256( key, input buffer ), from the key's midstates
+ *
+ * \param midstate the key's midstates, from HMAC_SHA256_precompute
+ * \param in       buffer holding the data
+ * \param n        length of the input data
+ * \param out      HMAC-SHA-224/256 result
+ */
+void HMAC_SHA256_from_midstate(const hmac_sha256_midstate *midstate, const uint8_t *in, size_t n, uint8_t* out);
 uint32_t TOTP_HMAC_SHA256(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, int is224);
 
 #endif /* mbedtls_sha256.h */
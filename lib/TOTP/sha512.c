@@ -57,6 +57,16 @@ static void mbedtls_zeroize( void *v, size_t n ) {
 }
 #endif /* GET_UINT64_BE */
 
+#ifndef GET_UINT32_BE
+#define GET_UINT32_BE(n,b,i)                            \
+{                                                       \
+    (n) = ( (uint32_t) (b)[(i)    ] << 24 )             \
+        | ( (uint32_t) (b)[(i) + 1] << 16 )             \
+        | ( (uint32_t) (b)[(i) + 2] <<  8 )             \
+        | ( (uint32_t) (b)[(i) + 3]       );            \
+}
+#endif /* GET_UINT32_BE */
+
 #ifndef PUT_UINT64_BE
 #define PUT_UINT64_BE(n,b,i)                            \
 {                                                       \
@@ -173,11 +183,111 @@ void mbedtls_sha512_starts( mbedtls_sha512_context *ctx, int is384 )
     ctx->is384 = is384;
 }
 
+#if defined(MBEDTLS_SHA512_32BIT_LIMBS)
+/*
+ * SHA-512 on 32-bit halves. Cores without native 64-bit registers (like the
+ * Cortex-M0+) turn every uint64_t rotate into shifts of both halves anyway;
+ * spelling that out lets rotates by 32 or more become a swap of the halves,
+ * and only the additions need a carry. The message schedule is kept as a
+ * 16-word ring rather than 80 words, which also saves 512 bytes of stack.
+ */
+typedef struct
+{
+    uint32_t hi;
+    uint32_t lo;
+}
+sha512_limbs;
+
+/* rotate right by n, for 0 < n < 32 */
+#define ROTR_LO(x,n) ((sha512_limbs) { ((x).hi >> (n)) | ((x).lo << (32 - (n))), ((x).lo >> (n)) | ((x).hi << (32 - (n))) })
+/* rotate right by 32 + n, for 0 < n < 32 */
+#define ROTR_HI(x,n) ((sha512_limbs) { ((x).lo >> (n)) | ((x).hi << (32 - (n))), ((x).hi >> (n)) | ((x).lo << (32 - (n))) })
+/* shift right by n, for 0 < n < 32 */
+#define SHR_LO(x,n)  ((sha512_limbs) { (x).hi >> (n), ((x).lo >> (n)) | ((x).hi << (32 - (n))) })
+
+static inline sha512_limbs limbs_xor3( sha512_limbs a, sha512_limbs b, sha512_limbs c )
+{
+    return (sha512_limbs) { a.hi ^ b.hi ^ c.hi, a.lo ^ b.lo ^ c.lo };
+}
+
+static inline sha512_limbs limbs_add( sha512_limbs a, sha512_limbs b )
+{
+    uint32_t lo = a.lo + b.lo;
+    return (sha512_limbs) { a.hi + b.hi + ( lo < a.lo ), lo };
+}
+
+#define L_S0(x) limbs_xor3( ROTR_LO(x, 1), ROTR_LO(x, 8), SHR_LO(x, 7) )
+#define L_S1(x) limbs_xor3( ROTR_LO(x,19), ROTR_HI(x,29), SHR_LO(x, 6) )
+#define L_S2(x) limbs_xor3( ROTR_LO(x,28), ROTR_HI(x, 2), ROTR_HI(x, 7) )
+#define L_S3(x) limbs_xor3( ROTR_LO(x,14), ROTR_LO(x,18), ROTR_HI(x, 9) )
+
+#define L_F0(x,y,z) ((sha512_limbs) { (x.hi & y.hi) | (z.hi & (x.hi | y.hi)), (x.lo & y.lo) | (z.lo & (x.lo | y.lo)) })
+#define L_F1(x,y,z) ((sha512_limbs) { z.hi ^ (x.hi & (y.hi ^ z.hi)), z.lo ^ (x.lo & (y.lo ^ z.lo)) })
+
+#define L_P(a,b,c,d,e,f,g,h,i)                                      \
+{                                                                   \
+    sha512_limbs k = { (uint32_t) ( K[i] >> 32 ), (uint32_t) K[i] }; \
+    if( (i) >= 16 )                                                 \
+        W[(i) & 15] = limbs_add( limbs_add( W[(i) & 15], L_S1( W[((i) - 2) & 15] ) ), \
+                                 limbs_add( W[((i) - 7) & 15], L_S0( W[((i) - 15) & 15] ) ) ); \
+    temp1 = limbs_add( limbs_add( h, L_S3(e) ), limbs_add( L_F1(e,f,g), limbs_add( k, W[(i) & 15] ) ) ); \
+    temp2 = limbs_add( L_S2(a), L_F0(a,b,c) );                      \
+    d = limbs_add( d, temp1 ); h = limbs_add( temp1, temp2 );       \
+}
+
 void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char data[SHA512_BLOCK_LENGTH] )
 {
     int i;
+    sha512_limbs temp1, temp2, W[16];
+    sha512_limbs A, B, C, D, E, F, G, H;
+
+    for( i = 0; i < 16; i++ )
+    {
+        GET_UINT32_BE( W[i].hi, data, i << 3 );
+        GET_UINT32_BE( W[i].lo, data, ( i << 3 ) + 4 );
+    }
+
+    A = (sha512_limbs) { (uint32_t) ( ctx->state[0] >> 32 ), (uint32_t) ctx->state[0] };
+    B = (sha512_limbs) { (uint32_t) ( ctx->state[1] >> 32 ), (uint32_t) ctx->state[1] };
+    C = (sha512_limbs) { (uint32_t) ( ctx->state[2] >> 32 ), (uint32_t) ctx->state[2] };
+    D = (sha512_limbs) { (uint32_t) ( ctx->state[3] >> 32 ), (uint32_t) ctx->state[3] };
+    E = (sha512_limbs) { (uint32_t) ( ctx->state[4] >> 32 ), (uint32_t) ctx->state[4] };
+    F = (sha512_limbs) { (uint32_t) ( ctx->state[5] >> 32 ), (uint32_t) ctx->state[5] };
+    G = (sha512_limbs) { (uint32_t) ( ctx->state[6] >> 32 ), (uint32_t) ctx->state[6] };
+    H = (sha512_limbs) { (uint32_t) ( ctx->state[7] >> 32 ), (uint32_t) ctx->state[7] };
+
+    for( i = 0; i < 80; i += 8 )
+    {
+        L_P( A, B, C, D, E, F, G, H, i + 0 );
+        L_P( H, A, B, C, D, E, F, G, i + 1 );
+        L_P( G, H, A, B, C, D, E, F, i + 2 );
+        L_P( F, G, H, A, B, C, D, E, i + 3 );
+        L_P( E, F, G, H, A, B, C, D, i + 4 );
+        L_P( D, E, F, G, H, A, B, C, i + 5 );
+        L_P( C, D, E, F, G, H, A, B, i + 6 );
+        L_P( B, C, D, E, F, G, H, A, i + 7 );
+    }
+
+    ctx->state[0] += ( (uint64_t) A.hi << 32 ) | A.lo;
+    ctx->state[1] += ( (uint64_t) B.hi << 32 ) | B.lo;
+    ctx->state[2] += ( (uint64_t) C.hi << 32 ) | C.lo;
+    ctx->state[3] += ( (uint64_t) D.hi << 32 ) | D.lo;
+    ctx->state[4] += ( (uint64_t) E.hi << 32 ) | E.lo;
+    ctx->state[5] += ( (uint64_t) F.hi << 32 ) | F.lo;
+    ctx->state[6] += ( (uint64_t) G.hi << 32 ) | G.lo;
+    ctx->state[7] += ( (uint64_t) H.hi << 32 ) | H.lo;
+}
+#else /* MBEDTLS_SHA512_32BIT_LIMBS */
+void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char data[SHA512_BLOCK_LENGTH] )
+{
+    int i;
+#if defined(MBEDTLS_SHA512_SMALLER)
+    uint64_t temp1, temp2, W[16];
+    uint64_t A[8];
+#else
     uint64_t temp1, temp2, W[80];
     uint64_t A, B, C, D, E, F, G, H;
+#endif
 
 #define SHR(x,n) (x >> n)
 #define ROTR(x,n) (SHR(x,n) | (x << (64 - n)))
@@ -198,6 +308,30 @@ void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char da
     d += temp1; h = temp1 + temp2;              \
 }
 
+#if defined(MBEDTLS_SHA512_SMALLER)
+    for( i = 0; i < 8; i++ )
+        A[i] = ctx->state[i];
+
+    /* the message schedule only ever looks 16 words back, so keep it in a ring */
+    for( i = 0; i < 80; i++ )
+    {
+        if( i < 16 )
+        {
+            GET_UINT64_BE( W[i], data, i << 3 );
+        }
+        else
+            W[i & 15] += S1(W[(i -  2) & 15]) + W[(i -  7) & 15] +
+                         S0(W[(i - 15) & 15]);
+
+        P( A[0], A[1], A[2], A[3], A[4], A[5], A[6], A[7], W[i & 15], K[i] );
+
+        temp1 = A[7]; A[7] = A[6]; A[6] = A[5]; A[5] = A[4]; A[4] = A[3];
+        A[3] = A[2]; A[2] = A[1]; A[1] = A[0]; A[0] = temp1;
+    }
+
+    for( i = 0; i < 8; i++ )
+        ctx->state[i] += A[i];
+#else /* MBEDTLS_SHA512_SMALLER */
     for( i = 0; i < 16; i++ )
     {
         GET_UINT64_BE( W[i], data, i << 3 );
@@ -240,7 +374,9 @@ void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char da
     ctx->state[5] += F;
     ctx->state[6] += G;
     ctx->state[7] += H;
+#endif /* MBEDTLS_SHA512_SMALLER */
 }
+#endif /* MBEDTLS_SHA512_32BIT_LIMBS */
 
 /*
  * SHA-512 process buffer
@@ -346,50 +482,90 @@ void mbedtls_sha512( const unsigned char *input, size_t ilen,
 }
 
 /*
-* Compute HMAC_SHA384/512 using key, key length, text to hash, size of the text, output buffer and a switch for SHA384
+* Compute the HMAC_SHA384/512 midstates for a key: the state after hashing the key XORd with ipad, and with opad
 */
-void HMAC_SHA512(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t* out, int is384){
-  int digest_length = SHA512_DIGEST_LENGTH;
-  if (is384 == 1) {
-    digest_length = SHA384_DIGEST_LENGTH;
-  }
+void HMAC_SHA512_precompute(const uint8_t* key, size_t key_length, hmac_sha512_midstate *midstate, int is384){
 
   uint8_t i;
-  uint8_t k_ipad[SHA512_BLOCK_LENGTH]; /* inner padding - key XORd with ipad */
-  uint8_t k_opad[SHA512_BLOCK_LENGTH]; /* outer padding - key XORd with opad */
-  uint8_t buffer[SHA512_BLOCK_LENGTH + digest_length];
+  uint8_t k_pad[SHA512_BLOCK_LENGTH]; /* key XORd with ipad, then opad */
+  mbedtls_sha512_context ctx;
 
-  /* start out by storing key in pads */
-  memset(k_ipad, 0, sizeof(k_ipad));
-  memset(k_opad, 0, sizeof(k_opad));
+  /* start out by storing key in the pad */
+  memset(k_pad, 0, sizeof(k_pad));
 
   if (key_length <= SHA512_BLOCK_LENGTH) {
-      memcpy(k_ipad, key, key_length);
-      memcpy(k_opad, key, key_length);
+      memcpy(k_pad, key, key_length);
   }
 
   else {
-      mbedtls_sha512(key, key_length, k_ipad, is384);
-      memcpy(k_opad, k_ipad, SHA512_BLOCK_LENGTH);
+      mbedtls_sha512(key, key_length, k_pad, is384);
   }
 
-  /* XOR key with ipad and opad values */
+  // hash the inner pad
   for (i = 0; i < SHA512_BLOCK_LENGTH; i++) {
-      k_ipad[i] ^= HMAC_IPAD;
-      k_opad[i] ^= HMAC_OPAD;
+      k_pad[i] ^= HMAC_IPAD;
   }
-  
+  mbedtls_sha512_starts(&ctx, is384);
+  mbedtls_sha512_process(&ctx, k_pad);
+  memcpy(midstate->inner, ctx.state, sizeof(midstate->inner));
+
+  // and the outer pad
+  for (i = 0; i < SHA512_BLOCK_LENGTH; i++) {
+      k_pad[i] ^= HMAC_IPAD ^ HMAC_OPAD;
+  }
+  mbedtls_sha512_starts(&ctx, is384);
+  mbedtls_sha512_process(&ctx, k_pad);
+  memcpy(midstate->outer, ctx.state, sizeof(midstate->outer));
+  midstate->is384 = is384;
+
+  mbedtls_zeroize(k_pad, sizeof(k_pad));
+  mbedtls_sha512_free(&ctx);
+}
+
+/*
+* Pick up a hash where a midstate left off, with one block already processed
+*/
+static void hmac_sha512_resume(mbedtls_sha512_context *ctx, const uint64_t state[8], int is384){
+  memcpy(ctx->state, state, sizeof(ctx->state));
+  ctx->total[0] = SHA512_BLOCK_LENGTH;
+  ctx->total[1] = 0;
+  ctx->is384 = is384;
+}
+
+/*
+* Compute HMAC_SHA384/512 using a key's midstates, text to hash, size of the text and output buffer
+*/
+void HMAC_SHA512_from_midstate(const hmac_sha512_midstate *midstate, const uint8_t *in, size_t n, uint8_t* out){
+  int digest_length = SHA512_DIGEST_LENGTH;
+  if (midstate->is384 == 1) {
+    digest_length = SHA384_DIGEST_LENGTH;
+  }
+
+  mbedtls_sha512_context ctx;
+
   // perform inner SHA512
-  memcpy(buffer, k_ipad, SHA512_BLOCK_LENGTH);
-  memcpy(buffer + SHA512_BLOCK_LENGTH, in, n);
-  mbedtls_sha512(buffer, SHA512_BLOCK_LENGTH + n, out, is384);
-  
-  memset(buffer, 0, SHA512_BLOCK_LENGTH + n);
+  hmac_sha512_resume(&ctx, midstate->inner, midstate->is384);
+  mbedtls_sha512_update(&ctx, in, n);
+  mbedtls_sha512_finish(&ctx, out);
 
   // perform outer SHA512
-  memcpy(buffer, k_opad, SHA512_BLOCK_LENGTH);
-  memcpy(buffer + SHA512_BLOCK_LENGTH, out, digest_length);
-  mbedtls_sha512(buffer, SHA512_BLOCK_LENGTH + digest_length, out, is384);
+  hmac_sha512_resume(&ctx, midstate->outer, midstate->is384);
+  mbedtls_sha512_update(&ctx, out, digest_length);
+  mbedtls_sha512_finish(&ctx, out);
+
+  mbedtls_sha512_free(&ctx);
+}
+
+/*
+* Compute HMAC_SHA384/512 using key, key length, text to hash, size of the text, output buffer and a switch for SHA384
+*/
+void HMAC_SHA512(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t* out, int is384){
+
+  hmac_sha512_midstate midstate;
+
+  HMAC_SHA512_precompute(key, key_length, &midstate, is384);
+  HMAC_SHA512_from_midstate(&midstate, in, n, out);
+  mbedtls_zeroize(&midstate, sizeof(midstate));
 }
 
 /*
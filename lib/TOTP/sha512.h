@@ -114,6 +114,40 @@ int mbedtls_sha512_self_test( int verbose );
 /* Internal use */
 void mbedtls_sha512_process( mbedtls_sha512_context *ctx, const unsigned char data[SHA512_BLOCK_LENGTH] );
 void HMAC_SHA512(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, uint8_t* out, int is384);
+
+/**
+ * \brief          HMAC-SHA-384/512 key midstates: the hash state after
+ *                 compressing the key XORd with ipad, and with opad. Computing
+ *                 them once per key saves two of the four compressions in
+ *                 every HMAC of a short message.
+ */
+typedef struct
+{
+    uint64_t inner[8];          /*!< state after the ipad block */
+    uint64_t outer[8];          /*!< state after the opad block */
+    int is384;                  /*!< 0 => SHA-512, else SHA-384 */
+}
+hmac_sha512_midstate;
+
+/**
+ * \brief          Compute the HMAC-SHA-384/512 midstates for a key
+ *
+ * \param key      the HMAC key
+ * \param key_length length of the key
+ * \param midstate receives the midstates
+ * \param is384    0 = use SHA512, 1 = use SHA384
+ */
+void HMAC_SHA512_precompute(const uint8_t* key, size_t key_length, hmac_sha512_midstate *midstate, int is384);
+
+/**
+ * \brief          Output = HMAC-SHA-384/512( key, input buffer ), from the key's midstates
+ *
+ * \param midstate the key's midstates, from HMAC_SHA512_precompute
+ * \param in       buffer holding the data
+ * \param n        length of the input data
+ * \param out      HMAC-SHA-384/512 result
+ */
+void HMAC_SHA512_from_midstate(const hmac_sha512_midstate *midstate, const uint8_t *in, size_t n, uint8_t* out);
 uint32_t TOTP_HMAC_SHA512(const uint8_t* key, size_t key_length, const uint8_t *in, size_t n, int is384);
 
 #endif /* mbedtls_sha512.h */
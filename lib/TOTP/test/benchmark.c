@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Times TOTP codes per second for each hash, both from the raw key (four compressions per code) and from a
+// precomputed midstate (two), so the kernel variants can be compared without hardware. For example:
+//
+//   cc -O2 -I.. benchmark.c ../TOTP.c ../sha1.c ../sha256.c ../sha512.c -o benchmark && ./benchmark
+//   cc -O2 -I.. -DMBEDTLS_SHA512_32BIT_LIMBS ... (or -DMBEDTLS_SHA1_SMALLER and friends)
+//
+// A desktop is no Cortex-M0+, so only compare variants against each other. Adding -m32 gets a little closer, since
+// the 64-bit arithmetic in SHA-512 then has to be done in halves, as it is on the watch. Check the size of each
+// variant with arm-none-eabi-size on the firmware's sha*.o.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include "../TOTP.h"
+
+#define BENCHMARK_SECONDS 1.0
+
+static const uint8_t key[] = "12345678901234567890123456789012345678901234567890123456789012345";
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double codes_per_second(hmac_alg algorithm, uint8_t key_length, bool precomputed) {
+  totp_hmac_state state;
+  uint32_t checksum = 0;
+  uint32_t steps = 0;
+  double start, elapsed;
+
+  TOTPInitState(&state, key, key_length, 30, algorithm);
+  start = now();
+  do {
+    // check the clock every so often rather than on every code.
+    for (uint16_t i = 0; i < 256; i++, steps++) {
+      if (!precomputed) TOTPInitState(&state, key, key_length, 30, algorithm);
+      checksum += getCodeFromStepsWithState(&state, steps);
+    }
+    elapsed = now() - start;
+  } while (elapsed < BENCHMARK_SECONDS);
+
+  // keep the compiler from throwing the work away.
+  if (checksum == 1) printf(" ");
+
+  return steps / elapsed;
+}
+
+int main(void) {
+  static const struct {
+    const char *name;
+    hmac_alg algorithm;
+    uint8_t key_length;
+  } cases[] = {
+    {"SHA1", SHA1, 20},
+    {"SHA224", SHA224, 28},
+    {"SHA256", SHA256, 32},
+    {"SHA384", SHA384, 48},
+    {"SHA512", SHA512, 64},
+  };
+
+  printf("kernels:");
+#if defined(MBEDTLS_SHA1_SMALLER)
+  printf(" SHA1_SMALLER");
+#endif
+#if defined(MBEDTLS_SHA256_SMALLER)
+  printf(" SHA256_SMALLER");
+#endif
+#if defined(MBEDTLS_SHA512_SMALLER)
+  printf(" SHA512_SMALLER");
+#endif
+#if defined(MBEDTLS_SHA512_32BIT_LIMBS)
+  printf(" SHA512_32BIT_LIMBS");
+#endif
+  printf(" (%zu-bit host)\n\n", sizeof(void *) * 8);
+
+  printf("%-8s %14s %14s\n", "", "fresh key/s", "midstate/s");
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    double fresh = codes_per_second(cases[i].algorithm, cases[i].key_length, false);
+    double precomputed = codes_per_second(cases[i].algorithm, cases[i].key_length, true);
+    printf("%-8s %14.0f %14.0f\n", cases[i].name, fresh, precomputed);
+  }
+
+  return 0;
+}
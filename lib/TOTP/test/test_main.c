@@ -0,0 +1,207 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Test vectors for the TOTP library: RFC 6238's TOTP codes and RFC 2202/4231's HMACs. Build and run on the host,
+// once for each variant of the hash kernels you care about, e.g. from this directory:
+//
+//   cc -I.. test_main.c unity.c ../TOTP.c ../sha1.c ../sha256.c ../sha512.c -o test_totp && ./test_totp
+//   cc -I.. -DMBEDTLS_SHA1_SMALLER -DMBEDTLS_SHA256_SMALLER -DMBEDTLS_SHA512_SMALLER ... (the rolled kernels)
+//   cc -I.. -DMBEDTLS_SHA512_32BIT_LIMBS ... (SHA-512 on 32-bit halves)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "../TOTP.h"
+#include "unity.h"
+
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// RFC 6238 appendix B. The library gives 6 digits, so these are the last 6 of the RFC's 8.
+static const uint8_t seed_sha1[] = "12345678901234567890";
+static const uint8_t seed_sha256[] = "12345678901234567890123456789012";
+static const uint8_t seed_sha512[] = "1234567890123456789012345678901234567890123456789012345678901234";
+
+#define RFC6238_VECTOR_COUNT 6
+static const uint64_t rfc6238_times[RFC6238_VECTOR_COUNT] = {59, 1111111109, 1111111111, 1234567890, 2000000000, 20000000000};
+static const uint32_t rfc6238_sha1[RFC6238_VECTOR_COUNT] = {287082, 81804, 50471, 5924, 279037, 353130};
+static const uint32_t rfc6238_sha256[RFC6238_VECTOR_COUNT] = {119246, 84774, 62674, 819424, 698825, 737706};
+static const uint32_t rfc6238_sha512[RFC6238_VECTOR_COUNT] = {693936, 91201, 943326, 441116, 618901, 863826};
+
+static void test_rfc6238_one(hmac_alg algorithm, const uint8_t *seed, uint8_t seed_length, const uint32_t *codes) {
+  totp_hmac_state state;
+  TOTPInitState(&state, seed, seed_length, 30, algorithm);
+
+  for (uint8_t i = 0; i < RFC6238_VECTOR_COUNT; ++i) {
+    // the last time doesn't fit in 32 bits, but its step count does.
+    TEST_ASSERT_EQUAL_UINT32(codes[i], getCodeFromStepsWithState(&state, rfc6238_times[i] / 30));
+    if (rfc6238_times[i] <= UINT32_MAX) {
+      TEST_ASSERT_EQUAL_UINT32(codes[i], getCodeFromTimestampWithState(&state, rfc6238_times[i]));
+    }
+  }
+}
+
+void test_rfc6238(void) {
+  test_rfc6238_one(SHA1, seed_sha1, sizeof(seed_sha1) - 1, rfc6238_sha1);
+  test_rfc6238_one(SHA256, seed_sha256, sizeof(seed_sha256) - 1, rfc6238_sha256);
+  test_rfc6238_one(SHA512, seed_sha512, sizeof(seed_sha512) - 1, rfc6238_sha512);
+}
+
+void test_cached_code(void) {
+  totp_hmac_state state;
+  totp_cached_code cache;
+  TOTPInitState(&state, seed_sha1, sizeof(seed_sha1) - 1, 30, SHA1);
+  memset(&cache, 0, sizeof(cache));
+
+  // filling it, staying within a step, moving on by one step (the next code) and jumping ahead (neither).
+  TEST_ASSERT_EQUAL_UINT32(81804, updateCachedCode(&state, &cache, 1111111109));
+  TEST_ASSERT_EQUAL_UINT32(getCodeFromStepsWithState(&state, 1111111109 / 30 + 1), cache.nextCode);
+  TEST_ASSERT_EQUAL_UINT32(81804, updateCachedCode(&state, &cache, 1111111109 - 29));
+  TEST_ASSERT_EQUAL_UINT32(50471, updateCachedCode(&state, &cache, 1111111111));
+  TEST_ASSERT_EQUAL_UINT32(5924, updateCachedCode(&state, &cache, 1234567890));
+  TEST_ASSERT_EQUAL_UINT32(getCodeFromStepsWithState(&state, 1234567890 / 30 + 1), cache.nextCode);
+  for (uint32_t t = 59; t < 59 + 30 * 4; t += 7) {
+    TEST_ASSERT_EQUAL_UINT32(getCodeFromTimestampWithState(&state, t), updateCachedCode(&state, &cache, t));
+  }
+}
+
+void test_legacy_interface(void) {
+  TOTP((uint8_t *)seed_sha1, sizeof(seed_sha1) - 1, 30, SHA1);
+  TEST_ASSERT_EQUAL_UINT32(287082, getCodeFromTimestamp(59));
+  TEST_ASSERT_EQUAL_UINT32(81804, getCodeFromSteps(1111111109 / 30));
+}
+
+// RFC 2202 and RFC 4231 test case 2 (a short key), and RFC 4231 test case 6 (a key longer than the block).
+static const uint8_t jefe_key[] = "Jefe";
+static const uint8_t jefe_data[] = "what do ya want for nothing?";
+static const uint8_t long_data[] = "Test Using Larger Than Block-Size Key - Hash Key First";
+
+static const uint8_t jefe_sha1[] = {
+  0xef, 0xfc, 0xdf, 0x6a, 0xe5, 0xeb, 0x2f, 0xa2, 0xd2, 0x74, 0x16, 0xd5, 0xf1, 0x84, 0xdf, 0x9c,
+  0x25, 0x9a, 0x7c, 0x79};
+static const uint8_t jefe_sha224[] = {
+  0xa3, 0x0e, 0x01, 0x09, 0x8b, 0xc6, 0xdb, 0xbf, 0x45, 0x69, 0x0f, 0x3a, 0x7e, 0x9e, 0x6d, 0x0f,
+  0x8b, 0xbe, 0xa2, 0xa3, 0x9e, 0x61, 0x48, 0x00, 0x8f, 0xd0, 0x5e, 0x44};
+static const uint8_t jefe_sha256[] = {
+  0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xc7,
+  0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43};
+static const uint8_t jefe_sha384[] = {
+  0xaf, 0x45, 0xd2, 0xe3, 0x76, 0x48, 0x40, 0x31, 0x61, 0x7f, 0x78, 0xd2, 0xb5, 0x8a, 0x6b, 0x1b,
+  0x9c, 0x7e, 0xf4, 0x64, 0xf5, 0xa0, 0x1b, 0x47, 0xe4, 0x2e, 0xc3, 0x73, 0x63, 0x22, 0x44, 0x5e,
+  0x8e, 0x22, 0x40, 0xca, 0x5e, 0x69, 0xe2, 0xc7, 0x8b, 0x32, 0x39, 0xec, 0xfa, 0xb2, 0x16, 0x49};
+static const uint8_t jefe_sha512[] = {
+  0x16, 0x4b, 0x7a, 0x7b, 0xfc, 0xf8, 0x19, 0xe2, 0xe3, 0x95, 0xfb, 0xe7, 0x3b, 0x56, 0xe0, 0xa3,
+  0x87, 0xbd, 0x64, 0x22, 0x2e, 0x83, 0x1f, 0xd6, 0x10, 0x27, 0x0c, 0xd7, 0xea, 0x25, 0x05, 0x54,
+  0x97, 0x58, 0xbf, 0x75, 0xc0, 0x5a, 0x99, 0x4a, 0x6d, 0x03, 0x4f, 0x65, 0xf8, 0xf0, 0xe6, 0xfd,
+  0xca, 0xea, 0xb1, 0xa3, 0x4d, 0x4a, 0x6b, 0x4b, 0x63, 0x6e, 0x07, 0x0a, 0x38, 0xbc, 0xe7, 0x37};
+
+static const uint8_t long_sha1[] = {
+  0x90, 0xd0, 0xda, 0xce, 0x1c, 0x1b, 0xdc, 0x95, 0x73, 0x39, 0x30, 0x78, 0x03, 0x16, 0x03, 0x35,
+  0xbd, 0xe6, 0xdf, 0x2b};
+static const uint8_t long_sha224[] = {
+  0x95, 0xe9, 0xa0, 0xdb, 0x96, 0x20, 0x95, 0xad, 0xae, 0xbe, 0x9b, 0x2d, 0x6f, 0x0d, 0xbc, 0xe2,
+  0xd4, 0x99, 0xf1, 0x12, 0xf2, 0xd2, 0xb7, 0x27, 0x3f, 0xa6, 0x87, 0x0e};
+static const uint8_t long_sha256[] = {
+  0x60, 0xe4, 0x31, 0x59, 0x1e, 0xe0, 0xb6, 0x7f, 0x0d, 0x8a, 0x26, 0xaa, 0xcb, 0xf5, 0xb7, 0x7f,
+  0x8e, 0x0b, 0xc6, 0x21, 0x37, 0x28, 0xc5, 0x14, 0x05, 0x46, 0x04, 0x0f, 0x0e, 0xe3, 0x7f, 0x54};
+static const uint8_t long_sha384[] = {
+  0x4e, 0xce, 0x08, 0x44, 0x85, 0x81, 0x3e, 0x90, 0x88, 0xd2, 0xc6, 0x3a, 0x04, 0x1b, 0xc5, 0xb4,
+  0x4f, 0x9e, 0xf1, 0x01, 0x2a, 0x2b, 0x58, 0x8f, 0x3c, 0xd1, 0x1f, 0x05, 0x03, 0x3a, 0xc4, 0xc6,
+  0x0c, 0x2e, 0xf6, 0xab, 0x40, 0x30, 0xfe, 0x82, 0x96, 0x24, 0x8d, 0xf1, 0x63, 0xf4, 0x49, 0x52};
+static const uint8_t long_sha512[] = {
+  0x80, 0xb2, 0x42, 0x63, 0xc7, 0xc1, 0xa3, 0xeb, 0xb7, 0x14, 0x93, 0xc1, 0xdd, 0x7b, 0xe8, 0xb4,
+  0x9b, 0x46, 0xd1, 0xf4, 0x1b, 0x4a, 0xee, 0xc1, 0x12, 0x1b, 0x01, 0x37, 0x83, 0xf8, 0xf3, 0x52,
+  0x6b, 0x56, 0xd0, 0x37, 0xe0, 0x5f, 0x25, 0x98, 0xbd, 0x0f, 0xd2, 0x21, 0x5d, 0x6a, 0x1e, 0x52,
+  0x95, 0xe6, 0x4f, 0x73, 0xf6, 0x3f, 0x0a, 0xec, 0x8b, 0x91, 0x5a, 0x98, 0x5d, 0x78, 0x65, 0x98};
+
+void test_hmac(void) {
+  uint8_t long_key[131];
+  uint8_t out[SHA512_DIGEST_LENGTH];
+  memset(long_key, 0xaa, sizeof(long_key));
+
+  HMAC_SHA1(jefe_key, sizeof(jefe_key) - 1, jefe_data, sizeof(jefe_data) - 1, out);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(jefe_sha1, out, SHA1_DIGEST_LENGTH);
+  HMAC_SHA256(jefe_key, sizeof(jefe_key) - 1, jefe_data, sizeof(jefe_data) - 1, out, 1);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(jefe_sha224, out, SHA224_DIGEST_LENGTH);
+  HMAC_SHA256(jefe_key, sizeof(jefe_key) - 1, jefe_data, sizeof(jefe_data) - 1, out, 0);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(jefe_sha256, out, SHA256_DIGEST_LENGTH);
+  HMAC_SHA512(jefe_key, sizeof(jefe_key) - 1, jefe_data, sizeof(jefe_data) - 1, out, 1);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(jefe_sha384, out, SHA384_DIGEST_LENGTH);
+  HMAC_SHA512(jefe_key, sizeof(jefe_key) - 1, jefe_data, sizeof(jefe_data) - 1, out, 0);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(jefe_sha512, out, SHA512_DIGEST_LENGTH);
+
+  HMAC_SHA1(long_key, sizeof(long_key), long_data, sizeof(long_data) - 1, out);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(long_sha1, out, SHA1_DIGEST_LENGTH);
+  HMAC_SHA256(long_key, sizeof(long_key), long_data, sizeof(long_data) - 1, out, 1);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(long_sha224, out, SHA224_DIGEST_LENGTH);
+  HMAC_SHA256(long_key, sizeof(long_key), long_data, sizeof(long_data) - 1, out, 0);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(long_sha256, out, SHA256_DIGEST_LENGTH);
+  HMAC_SHA512(long_key, sizeof(long_key), long_data, sizeof(long_data) - 1, out, 1);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(long_sha384, out, SHA384_DIGEST_LENGTH);
+  HMAC_SHA512(long_key, sizeof(long_key), long_data, sizeof(long_data) - 1, out, 0);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(long_sha512, out, SHA512_DIGEST_LENGTH);
+}
+
+void test_midstate_matches_hmac(void) {
+  // the midstates should give the same answer as the full HMAC, whatever the message length.
+  uint8_t message[300];
+  uint8_t expected[SHA512_DIGEST_LENGTH];
+  uint8_t out[SHA512_DIGEST_LENGTH];
+  hmac_sha1_midstate sha1;
+  hmac_sha256_midstate sha256;
+  hmac_sha512_midstate sha512;
+
+  for (uint16_t i = 0; i < sizeof(message); ++i) message[i] = (uint8_t)(i * 7 + 3);
+  HMAC_SHA1_precompute(seed_sha1, sizeof(seed_sha1) - 1, &sha1);
+  HMAC_SHA256_precompute(seed_sha256, sizeof(seed_sha256) - 1, &sha256, 0);
+  HMAC_SHA512_precompute(seed_sha512, sizeof(seed_sha512) - 1, &sha512, 0);
+
+  for (uint16_t n = 0; n <= sizeof(message); n += 37) {
+    HMAC_SHA1(seed_sha1, sizeof(seed_sha1) - 1, message, n, expected);
+    HMAC_SHA1_from_midstate(&sha1, message, n, out);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, SHA1_DIGEST_LENGTH);
+
+    HMAC_SHA256(seed_sha256, sizeof(seed_sha256) - 1, message, n, expected, 0);
+    HMAC_SHA256_from_midstate(&sha256, message, n, out);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, SHA256_DIGEST_LENGTH);
+
+    HMAC_SHA512(seed_sha512, sizeof(seed_sha512) - 1, message, n, expected, 0);
+    HMAC_SHA512_from_midstate(&sha512, message, n, out);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, SHA512_DIGEST_LENGTH);
+  }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_rfc6238);
+  RUN_TEST(test_cached_code);
+  RUN_TEST(test_legacy_interface);
+  RUN_TEST(test_hmac);
+  RUN_TEST(test_midstate_matches_hmac);
+  return UNITY_END();
+}
@@ -0,0 +1,314 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Wesley Ellis (https://github.com/tahnok)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base32.h"
+
+#include "totp_db.h"
+
+// Imports are written here, and only replace the database once they're complete.
+#define TOTP_DB_TEMP_FILE "totp.db.tmp"
+// Bump the version at the end if struct totp_record or struct totp_db_source changes.
+#define TOTP_DB_MAGIC "TOTP2"
+
+static const char* TOTP_URI_START = "otpauth://totp/";
+
+/* Follows the magic at the start of the database: what totp_uris.txt
+ * looked like when the database was built, so that it can be imported
+ * again once it has changed.
+ */
+struct totp_db_source {
+    int32_t size; // -1 if there was no such file
+    uint8_t digest[SHA1_DIGEST_LENGTH];
+};
+
+// Secrets are decoded into here while importing the URIs.
+static uint8_t current_secret[TOTP_DB_MAX_SECRET_SIZE];
+
+static uint16_t generation = 0;
+
+static void init_totp_record(struct totp_record *totp_record) {
+    totp_record->label[0] = 'A';
+    totp_record->label[1] = 'A';
+    totp_record->label[2] = 'A';
+    totp_record->label[3] = 0;
+    totp_record->algorithm = SHA1;
+    totp_record->period = 30;
+    totp_record->secret_size = 0;
+}
+
+static bool totp_db_read_param(struct totp_record *totp_record, char *param, char *value) {
+    if (!strcmp(param, "issuer")) {
+        if (value[0] == '\0') {
+            printf("TOTP issuer must be a non-empty string\n");
+            return false;
+        }
+        snprintf(totp_record->label, sizeof(totp_record->label), "%-3s", value);
+    } else if (!strcmp(param, "secret")) {
+        if (UNBASE32_LEN(strlen(value)) > TOTP_DB_MAX_SECRET_SIZE) {
+            printf("TOTP secret too long: %s\n", value);
+            return false;
+        }
+        totp_record->secret_size = base32_decode((unsigned char *)value, current_secret);
+        if (totp_record->secret_size == 0) {
+            printf("TOTP can't decode secret: %s\n", value);
+            return false;
+        }
+    } else if (!strcmp(param, "digits")) {
+        if (!strcmp(param, "6")) {
+            printf("TOTP got %s, not 6 digits\n", value);
+            return false;
+        }
+    } else if (!strcmp(param, "period")) {
+        totp_record->period = atoi(value);
+        if (totp_record->period == 0) {
+            printf("TOTP invalid period %s\n", value);
+            return false;
+        }
+    } else if (!strcmp(param, "algorithm")) {
+        if (!strcmp(value, "SHA1")) {
+            totp_record->algorithm = SHA1;
+        }
+        else if (!strcmp(value, "SHA224")) {
+            totp_record->algorithm = SHA224;
+        }
+        else if (!strcmp(value, "SHA256")) {
+            totp_record->algorithm = SHA256;
+        }
+        else if (!strcmp(value, "SHA384")) {
+            totp_record->algorithm = SHA384;
+        }
+        else if (!strcmp(value, "SHA512")) {
+            totp_record->algorithm = SHA512;
+        }
+        else {
+            printf("TOTP ignored due to algorithm %s\n", value);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int16_t totp_db_import_file(char *filename, filesystem_handle_t db) {
+    // For 'format' of file, see totp_db.h.
+    const size_t uri_start_len = strlen(TOTP_URI_START);
+    int16_t count = 0;
+
+    filesystem_line_reader_t reader;
+    char buffer[256];
+    if (!filesystem_line_reader_open(&reader, filename, buffer, sizeof(buffer))) {
+        printf("TOTP file error: %s\n", filename);
+        return -1;
+    }
+
+    char *line;
+    int32_t line_length;
+    while ((line = filesystem_line_reader_next(&reader, &line_length)) && line_length) {
+        if (count == TOTP_DB_MAX_RECORDS) {
+            printf("TOTP max records: %d\n", TOTP_DB_MAX_RECORDS);
+            break;
+        }
+
+        // Check that it looks like a URI
+        if (strncmp(TOTP_URI_START, line, uri_start_len)) {
+            printf("TOTP invalid uri start: %s\n", line);
+            continue;
+        }
+
+        // Check that we can find a '?' (to start our parameters)
+        char *param;
+        char *param_saveptr = NULL;
+        char *params = strchr(line + uri_start_len, '?');
+        if (params == NULL) {
+            printf("TOTP no params: %s\n", line);
+            continue;
+        }
+
+        // Process the parameters and put them in the record
+        struct totp_record record;
+        init_totp_record(&record);
+        bool error = false;
+        param = strtok_r(params + 1, "&", &param_saveptr);
+        do {
+            char *param_middle = strchr(param, '=');
+            *param_middle = '\0';
+            if (!totp_db_read_param(&record, param, param_middle + 1)) {
+                error = true;
+            }
+        } while ((param = strtok_r(NULL, "&", &param_saveptr)));
+
+        if (error) {
+            continue;
+        }
+
+        // If we found a probably valid TOTP record, write it and its decoded secret to the database.
+        if (record.secret_size) {
+            if (!filesystem_append(db, (char *)&record, sizeof(record)) ||
+                !filesystem_append(db, (char *)current_secret, record.secret_size)) {
+                printf("TOTP can't write %s\n", TOTP_DB_FILE);
+                count = -1;
+                break;
+            }
+            count += 1;
+        } else {
+            printf("TOTP missing secret: %s\n", line);
+        }
+    }
+
+    memset(current_secret, 0, sizeof(current_secret));
+    filesystem_line_reader_close(&reader);
+
+    return count;
+}
+
+static void totp_db_get_source(struct totp_db_source *source) {
+    memset(source, 0, sizeof(*source));
+    source->size = -1;
+
+    filesystem_handle_t handle = filesystem_open(TOTP_DB_URI_FILE, FILESYSTEM_OPEN_READ);
+    if (handle < 0) {
+        return;
+    }
+
+    mbedtls_sha1_context context;
+    mbedtls_sha1_init(&context);
+    mbedtls_sha1_starts(&context);
+    uint8_t buffer[64];
+    int32_t bytes_read;
+    source->size = 0;
+    while ((bytes_read = filesystem_read(handle, (char *)buffer, sizeof(buffer))) > 0) {
+        mbedtls_sha1_update(&context, buffer, bytes_read);
+        source->size += bytes_read;
+    }
+    mbedtls_sha1_finish(&context, source->digest);
+    mbedtls_sha1_free(&context);
+    filesystem_close(handle);
+}
+
+int16_t totp_db_import(char *filename) {
+    // noted even when importing from another file, so that only a change to totp_uris.txt imports it again.
+    struct totp_db_source source;
+    totp_db_get_source(&source);
+
+    filesystem_handle_t db = filesystem_open(TOTP_DB_TEMP_FILE, FILESYSTEM_OPEN_WRITE);
+    if (db < 0) {
+        printf("TOTP can't write %s\n", TOTP_DB_TEMP_FILE);
+        return -1;
+    }
+
+    int16_t count = -1;
+    if (filesystem_append(db, (char *)TOTP_DB_MAGIC, sizeof(TOTP_DB_MAGIC)) &&
+        filesystem_append(db, (char *)&source, sizeof(source))) {
+        count = totp_db_import_file(filename, db);
+    }
+
+    if (!filesystem_close(db) || count < 0 || !filesystem_rename(TOTP_DB_TEMP_FILE, TOTP_DB_FILE)) {
+        // don't leave half a database behind; the old one is still there, and the next import can try again.
+        filesystem_rm(TOTP_DB_TEMP_FILE);
+        return -1;
+    }
+    generation += 1;
+
+    return count;
+}
+
+bool totp_db_refresh(void) {
+    struct totp_db_source source;
+    totp_db_get_source(&source);
+    if (source.size < 0) {
+        // nothing to import; keep whatever we have.
+        return false;
+    }
+
+    struct totp_db_source built_from;
+    char magic[sizeof(TOTP_DB_MAGIC)];
+    filesystem_handle_t db = filesystem_open(TOTP_DB_FILE, FILESYSTEM_OPEN_READ);
+    if (db >= 0) {
+        bool current = filesystem_read(db, magic, sizeof(magic)) == sizeof(magic) &&
+                       !memcmp(magic, TOTP_DB_MAGIC, sizeof(magic)) &&
+                       filesystem_read(db, (char *)&built_from, sizeof(built_from)) == sizeof(built_from) &&
+                       !memcmp(&built_from, &source, sizeof(source));
+        filesystem_close(db);
+        if (current) {
+            return false;
+        }
+    }
+
+    return totp_db_import(TOTP_DB_URI_FILE) >= 0;
+}
+
+filesystem_handle_t totp_db_open(void) {
+    filesystem_handle_t db = filesystem_open(TOTP_DB_FILE, FILESYSTEM_OPEN_READ);
+    if (db < 0) {
+        return -1;
+    }
+
+    char magic[sizeof(TOTP_DB_MAGIC)];
+    struct totp_db_source source;
+    if (filesystem_read(db, magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, TOTP_DB_MAGIC, sizeof(magic)) ||
+        filesystem_read(db, (char *)&source, sizeof(source)) != sizeof(source)) {
+        printf("TOTP %s is not a database; import %s again\n", TOTP_DB_FILE, TOTP_DB_URI_FILE);
+        filesystem_close(db);
+        return -1;
+    }
+
+    return db;
+}
+
+bool totp_db_read_record(filesystem_handle_t db, struct totp_record *record, uint8_t *secret) {
+    // Fixed-size headers, each followed by its secret: no parsing, and no decoding.
+    if (filesystem_read(db, (char *)record, sizeof(*record)) != sizeof(*record)) {
+        return false;
+    }
+    if (record->secret_size == 0 || record->secret_size > TOTP_DB_MAX_SECRET_SIZE ||
+        record->algorithm > SHA512 || record->period == 0 ||
+        filesystem_read(db, (char *)secret, record->secret_size) != record->secret_size) {
+        printf("TOTP %s is damaged; import %s again\n", TOTP_DB_FILE, TOTP_DB_URI_FILE);
+        return false;
+    }
+    record->label[sizeof(record->label) - 1] = '\0';
+
+    return true;
+}
+
+uint16_t totp_db_get_generation(void) {
+    return generation;
+}
+
+int totp_db_cmd_import(int argc, char *argv[]) {
+    char *filename = argc > 1 ? argv[1] : TOTP_DB_URI_FILE;
+    int16_t count = totp_db_import(filename);
+
+    if (count < 0) {
+        printf("TOTP import failed\r\n");
+        return -1;
+    }
+    printf("TOTP imported %d records into %s\r\n", count, TOTP_DB_FILE);
+
+    return 0;
+}
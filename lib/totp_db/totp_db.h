@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Wesley Ellis (https://github.com/tahnok)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "TOTP.h"
+#include "filesystem.h"
+
+/*
+ * TOTP database
+ *
+ * Parses otpauth URIs, one per line, from totp_uris.txt (or another file)
+ * into totp.db: fixed-size records, each followed by its decoded secret,
+ * so that reading them back takes no parsing and no base32 decoding.
+ *
+ * The format of the URIs is:
+ *
+ *   otpauth://totp/Example:alice@google.com?secret=JBSWY3DPEHPK3PXP&issuer=Example
+ *
+ * of which only the issuer (shortened to its first three characters),
+ * secret, period and algorithm are used.
+ *
+ * Imports are written to a temporary file that only replaces the
+ * database once it's complete, so a failed import keeps the old one.
+ * The database also notes what totp_uris.txt looked like when it was
+ * built, so that totp_db_refresh can import it again once it changes.
+ */
+
+#define TOTP_DB_MAX_RECORDS 30
+#define TOTP_DB_MAX_SECRET_SIZE 128
+#define TOTP_DB_URI_FILE "totp_uris.txt"
+#define TOTP_DB_FILE "totp.db"
+
+/* Also the database's on-disk format, followed by secret_size bytes
+ * of decoded secret.
+ */
+struct totp_record {
+    char label[4];
+    hmac_alg algorithm;
+    uint8_t period;
+    uint8_t secret_size;
+};
+
+/** @brief Parses a file of otpauth URIs into the database, replacing whatever was in it.
+  * @param filename The file to import.
+  * @return the number of records, or -1 if it failed, in which case the old database is left as it was.
+  */
+int16_t totp_db_import(char *filename);
+
+/** @brief Imports totp_uris.txt if it has changed since the database was built, or if there's no
+  *        database yet.
+  * @return true if it imported it.
+  */
+bool totp_db_refresh(void);
+
+/** @brief Opens the database for totp_db_read_record.
+  * @return a handle to close with filesystem_close, or -1 if there's no database or it isn't one.
+  */
+filesystem_handle_t totp_db_open(void);
+
+/** @brief Reads the next record from the database.
+  * @param db A handle from totp_db_open.
+  * @param record The record's header.
+  * @param secret Its decoded secret: TOTP_DB_MAX_SECRET_SIZE bytes, of which record->secret_size are used.
+  * @return false at the end of the database, or if it's damaged.
+  */
+bool totp_db_read_record(filesystem_handle_t db, struct totp_record *record, uint8_t *secret);
+
+/** @brief Counts the imports so far, so that anything holding records read from the database can
+  *        tell when to read it again.
+  */
+uint16_t totp_db_get_generation(void);
+
+/// @brief Shell command: parses totp_uris.txt (or the file given) into the database.
+int totp_db_cmd_import(int argc, char *argv[]);
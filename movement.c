@@ -41,6 +41,7 @@
 #include "shell.h"
 #include "utz.h"
 #include "zones.h"
+#include "tz_transitions.h"
 #include "tc.h"
 #include "evsys.h"
 #include "delay.h"
@@ -53,13 +54,14 @@
 #if __EMSCRIPTEN__
 #include <emscripten.h>
 void _wake_up_simulator(void);
+#elif defined(WATCH_HOST)
+#include "watch_host_energy.h"
 #else
 #include "watch_usb_cdc.h"
 #endif
 
 volatile movement_state_t movement_state;
 void * watch_face_contexts[MOVEMENT_NUM_FACES];
-watch_date_time_t scheduled_tasks[MOVEMENT_NUM_FACES];
 const int32_t movement_le_inactivity_deadlines[8] = {INT_MAX, 600, 3600, 7200, 21600, 43200, 86400, 604800};
 const int16_t movement_timeout_inactivity_deadlines[4] = {60, 120, 300, 1800};
 
@@ -92,6 +94,7 @@ typedef struct {
     volatile uint8_t subsecond;
     volatile rtc_counter_t minute_counter;
     volatile bool minute_alarm_fired;
+    volatile bool timer_fired;
     volatile bool is_buzzing;
     volatile uint8_t pending_sequence_priority;
     volatile bool schedule_next_comp;
@@ -111,6 +114,44 @@ movement_volatile_state_t movement_volatile_state;
 // The last sequence that we have been asked to play while the watch was in deep sleep
 static int8_t *_pending_sequence;
 
+// Running software timers, as a binary min-heap ordered by deadline. There are extra slots for the
+// timers that run the background tasks and flush the key-value store.
+static movement_timer_t *_movement_timers[MOVEMENT_MAX_TIMERS + 2];
+static uint8_t _movement_num_timers;
+
+// Background tasks, as a binary min-heap ordered by timestamp. Only the earliest has a timer running.
+#ifndef MOVEMENT_MAX_BACKGROUND_TASKS
+#define MOVEMENT_MAX_BACKGROUND_TASKS (MOVEMENT_NUM_FACES * 2)
+#endif
+
+typedef struct {
+    uint32_t timestamp;
+    uint32_t payload;
+    uint8_t watch_face_index;
+    uint8_t task_id;
+    bool keep_awake;
+} movement_background_task_t;
+
+static movement_background_task_t _movement_background_tasks[MOVEMENT_MAX_BACKGROUND_TASKS];
+static uint8_t _movement_num_background_tasks;
+// tasks scheduled through movement_schedule_background_task keep the watch out of low energy mode while pending.
+static uint8_t _movement_num_keep_awake_tasks;
+static movement_timer_t _movement_background_task_timer;
+// the task being handled right now, for movement_get_background_task_id and friends.
+static movement_background_task_t _movement_current_background_task;
+
+// Values put in the key-value store wait here, so that a wearer clicking through settings costs one flash commit
+// rather than one per click. They're flushed when the face resigns, before low energy mode, or after a while.
+#ifndef MOVEMENT_KV_QUEUE_SIZE
+#define MOVEMENT_KV_QUEUE_SIZE 8
+#endif
+#define MOVEMENT_KV_FLUSH_DELAY 30 // seconds
+
+static uint16_t _movement_kv_queue_keys[MOVEMENT_KV_QUEUE_SIZE];
+static uint32_t _movement_kv_queue_values[MOVEMENT_KV_QUEUE_SIZE];
+static uint8_t _movement_kv_queue_length;
+static movement_timer_t _movement_kv_flush_timer;
+
 // The note sequence of the default alarm
 int8_t alarm_tune[] = {
     BUZZER_NOTE_C8, 3,
@@ -125,14 +166,22 @@ int8_t alarm_tune[] = {
     0
 };
 
+// The current offset of every zone, in 15-minute units, so that looking one up doesn't need a search.
 int8_t _movement_dst_offset_cache[NUM_ZONE_NAMES] = {0};
-#define TIMEZONE_DOES_NOT_OBSERVE (-127)
+
+// For each zone, the UTC timestamp at which its offset next changes. The cache above holds until the earliest of
+// these, and only needs to be re-evaluated for the zones whose transition has passed.
+static uint32_t _movement_dst_next_transition[NUM_ZONE_NAMES];
+static uint32_t _movement_dst_earliest_transition;
+// the last time any zone was evaluated; the cache is also stale before this.
+static uint32_t _movement_dst_cache_valid_from;
 
 void cb_mode_btn_interrupt(void);
 void cb_light_btn_interrupt(void);
 void cb_alarm_btn_interrupt(void);
 void cb_alarm_btn_extwake(void);
 void cb_minute_alarm_fired(void);
+void cb_timer_fired(void);
 void cb_tick(void);
 void cb_mode_btn_timeout_interrupt(void);
 void cb_light_btn_timeout_interrupt(void);
@@ -146,7 +195,7 @@ void cb_buzzer_stop(void);
 void cb_accelerometer_event(void);
 void cb_accelerometer_wake(void);
 
-#if __EMSCRIPTEN__
+#if __EMSCRIPTEN__ || defined(WATCH_HOST)
 void yield(void) {
 }
 #else
@@ -156,18 +205,6 @@ void yield(void) {
 }
 #endif
 
-static udatetime_t _movement_convert_date_time_to_udate(watch_date_time_t date_time) {
-    return (udatetime_t) {
-        .date.dayofmonth = date_time.unit.day,
-        .date.dayofweek = dayofweek(UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR), date_time.unit.month, date_time.unit.day),
-        .date.month = date_time.unit.month,
-        .date.year = UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR),
-        .time.hour = date_time.unit.hour,
-        .time.minute = date_time.unit.minute,
-        .time.second = date_time.unit.second
-    };
-}
-
 static watch_buzzer_volume_t _movement_get_buzzer_volume(movement_buzzer_priority_t priority) {
     switch (priority) {
         case BUZZER_PRIORITY_BUTTON:
@@ -216,31 +253,50 @@ static void _movement_set_top_of_minute_alarm() {
     movement_volatile_state.schedule_next_comp = true;
 }
 
+static bool _movement_update_dst_offset_for_zone(uint8_t zone_index, uint32_t timestamp) {
+    int8_t new_offset = tz_transitions_offset_at(zone_index, timestamp, &_movement_dst_next_transition[zone_index]);
+    bool dst_changed = _movement_dst_offset_cache[zone_index] != new_offset;
+
+    _movement_dst_offset_cache[zone_index] = new_offset;
+
+    return dst_changed;
+}
+
+static void _movement_update_earliest_dst_transition(uint32_t timestamp) {
+    _movement_dst_earliest_transition = UINT32_MAX;
+    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+        if (_movement_dst_next_transition[i] < _movement_dst_earliest_transition) {
+            _movement_dst_earliest_transition = _movement_dst_next_transition[i];
+        }
+    }
+    _movement_dst_cache_valid_from = timestamp;
+}
+
 static bool _movement_update_dst_offset_cache(void) {
-    uzone_t local_zone;
-    udatetime_t udate_time;
+    uint32_t timestamp = watch_rtc_get_unix_time();
     bool dst_changed = false;
-    watch_date_time_t system_date_time = watch_rtc_get_date_time();
 
     for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
-        unpack_zone(&zone_defns[i], "", &local_zone);
-        watch_date_time_t date_time = watch_utility_date_time_convert_zone(system_date_time, 0, local_zone.offset.hours * 3600 + local_zone.offset.minutes * 60);
-
-        if (!!local_zone.rules_len) {
-            // if local zone has DST rules, we need to see if DST applies.
-            udate_time = _movement_convert_date_time_to_udate(date_time);
-            uoffset_t offset;
-            get_current_offset(&local_zone, &udate_time, &offset);
-            int8_t new_offset = (offset.hours * 60 + offset.minutes) / 15;
-            if (_movement_dst_offset_cache[i] != new_offset) {
-                _movement_dst_offset_cache[i] = new_offset;
-                dst_changed = true;
-            }
-        } else {
-            // otherwise set the cache to a constant value that indicates no DST check needs to be performed.
-            _movement_dst_offset_cache[i] = TIMEZONE_DOES_NOT_OBSERVE;
+        dst_changed |= _movement_update_dst_offset_for_zone(i, timestamp);
+    }
+    _movement_update_earliest_dst_transition(timestamp);
+
+    return dst_changed;
+}
+
+static bool _movement_check_dst_transitions(void) {
+    uint32_t timestamp = watch_rtc_get_unix_time();
+    bool dst_changed = false;
+
+    // this is the common case, every minute but a couple of times a year.
+    if (timestamp < _movement_dst_earliest_transition) return false;
+
+    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+        if (_movement_dst_next_transition[i] <= timestamp) {
+            dst_changed |= _movement_update_dst_offset_for_zone(i, timestamp);
         }
     }
+    _movement_update_earliest_dst_transition(timestamp);
 
     return dst_changed;
 }
@@ -366,12 +422,8 @@ static void _movement_handle_button_presses(uint32_t pending_events) {
 }
 
 static void _movement_handle_top_of_minute(void) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
-
-    // update the DST offset cache every 30 minutes, since someplace in the world could change.
-    if (date_time.unit.minute % 30 == 0) {
-        _movement_update_dst_offset_cache();
-    }
+    // update the DST offset cache for any zone that just crossed a transition.
+    _movement_check_dst_transitions();
 
     for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
         // For each face that offers an advisory...
@@ -383,6 +435,7 @@ static void _movement_handle_top_of_minute(void) {
             if (advisory.wants_background_task) {
                 // we give it one. pretty straightforward!
                 movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
+                _movement_current_background_task = (movement_background_task_t) { .watch_face_index = i };
                 watch_faces[i].loop(background_event, watch_face_contexts[i]);
             }
 
@@ -391,33 +444,6 @@ static void _movement_handle_top_of_minute(void) {
     }
 }
 
-static void _movement_handle_scheduled_tasks(void) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
-    uint8_t num_active_tasks = 0;
-
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg) {
-            if (scheduled_tasks[i].reg <= date_time.reg) {
-                scheduled_tasks[i].reg = 0;
-                movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
-                // check if loop scheduled a new task
-                if (scheduled_tasks[i].reg) {
-                    num_active_tasks++;
-                }
-            } else {
-                num_active_tasks++;
-            }
-        }
-    }
-
-    if (num_active_tasks == 0) {
-        movement_state.has_scheduled_background_task = false;
-    } else {
-        _movement_reset_inactivity_countdown();
-    }
-}
-
 void movement_request_tick_frequency(uint8_t freq) {
     // Movement requires at least a 1 Hz tick.
     // If we are asked for an invalid frequency, default back to 1 Hz.
@@ -438,6 +464,282 @@ void movement_request_tick_frequency(uint8_t freq) {
     watch_rtc_register_periodic_callback(cb_tick, freq);
 }
 
+static inline bool _movement_timer_before(const movement_timer_t *a, const movement_timer_t *b) {
+    // deadlines wrap along with the RTC counter, so compare them relative to each other.
+    return (int32_t)(a->deadline - b->deadline) < 0;
+}
+
+static void _movement_timer_place(movement_timer_t *timer, uint8_t index) {
+    _movement_timers[index] = timer;
+    timer->heap_slot = index + 1;
+}
+
+static void _movement_timer_sift_up(uint8_t index) {
+    movement_timer_t *timer = _movement_timers[index];
+
+    while (index > 0) {
+        uint8_t parent = (index - 1) / 2;
+        if (!_movement_timer_before(timer, _movement_timers[parent])) break;
+        _movement_timer_place(_movement_timers[parent], index);
+        index = parent;
+    }
+
+    _movement_timer_place(timer, index);
+}
+
+static void _movement_timer_sift_down(uint8_t index) {
+    movement_timer_t *timer = _movement_timers[index];
+
+    while (true) {
+        uint8_t child = index * 2 + 1;
+        if (child >= _movement_num_timers) break;
+        if (child + 1 < _movement_num_timers && _movement_timer_before(_movement_timers[child + 1], _movement_timers[child])) child++;
+        if (!_movement_timer_before(_movement_timers[child], timer)) break;
+        _movement_timer_place(_movement_timers[child], index);
+        index = child;
+    }
+
+    _movement_timer_place(timer, index);
+}
+
+static void _movement_timer_remove(movement_timer_t *timer) {
+    uint8_t index = timer->heap_slot - 1;
+    timer->heap_slot = 0;
+    _movement_num_timers--;
+
+    // move the last timer into the hole, then let it find its place in either direction.
+    if (index == _movement_num_timers) return;
+    movement_timer_t *moved = _movement_timers[_movement_num_timers];
+    _movement_timer_place(moved, index);
+    _movement_timer_sift_up(index);
+    _movement_timer_sift_down(moved->heap_slot - 1);
+}
+
+static void _movement_timer_schedule_head(void) {
+    // only the earliest timer needs the RTC's attention.
+    if (_movement_num_timers) {
+        watch_rtc_register_comp_callback_no_schedule(cb_timer_fired, _movement_timers[0]->deadline, TIMER_TIMEOUT);
+    } else {
+        watch_rtc_disable_comp_callback_no_schedule(TIMER_TIMEOUT);
+    }
+    movement_volatile_state.schedule_next_comp = true;
+}
+
+static void _movement_handle_timers(void) {
+    // anything a callback starts is at least one tick out, so this loop always ends.
+    rtc_counter_t counter = watch_rtc_get_counter();
+
+    while (_movement_num_timers && (int32_t)(counter - _movement_timers[0]->deadline) >= 0) {
+        movement_timer_t *timer = _movement_timers[0];
+
+        if (timer->period) {
+            // skip any periods we missed rather than firing once for each of them.
+            do {
+                timer->deadline += timer->period;
+            } while ((int32_t)(counter - timer->deadline) >= 0);
+            _movement_timer_sift_down(0);
+        } else {
+            _movement_timer_remove(timer);
+        }
+
+        timer->callback(timer->context);
+    }
+
+    _movement_timer_schedule_head();
+}
+
+static void _movement_timer_start(movement_timer_t *timer, uint32_t delay_ticks, uint32_t period_ticks, movement_timer_cb_t callback, void *context) {
+    if (timer->heap_slot) _movement_timer_remove(timer);
+
+    // deadlines are compared as signed differences, so keep them within half the counter's range.
+    if (delay_ticks == 0) delay_ticks = 1;
+    if (delay_ticks > INT32_MAX) delay_ticks = INT32_MAX;
+    if (period_ticks > INT32_MAX) period_ticks = INT32_MAX;
+
+    timer->deadline = watch_rtc_get_counter() + delay_ticks;
+    timer->period = period_ticks;
+    timer->callback = callback;
+    timer->context = context;
+
+    _movement_timers[_movement_num_timers] = timer;
+    _movement_num_timers++;
+    _movement_timer_sift_up(_movement_num_timers - 1);
+    if (_movement_timers[0] == timer) _movement_timer_schedule_head();
+}
+
+bool movement_timer_start(movement_timer_t *timer, uint32_t delay_ticks, uint32_t period_ticks, movement_timer_cb_t callback, void *context) {
+    // Movement's own timers have reserved slots in the heap.
+    uint8_t reserved = (_movement_background_task_timer.heap_slot ? 1 : 0) + (_movement_kv_flush_timer.heap_slot ? 1 : 0);
+    if (!timer->heap_slot && _movement_num_timers - reserved >= MOVEMENT_MAX_TIMERS) return false;
+
+    _movement_timer_start(timer, delay_ticks, period_ticks, callback, context);
+
+    return true;
+}
+
+void movement_timer_stop(movement_timer_t *timer) {
+    if (!timer->heap_slot) return;
+
+    bool was_head = _movement_timers[0] == timer;
+    _movement_timer_remove(timer);
+    if (was_head) _movement_timer_schedule_head();
+}
+
+bool movement_timer_is_running(movement_timer_t *timer) {
+    return timer->heap_slot != 0;
+}
+
+static uint32_t _movement_ticks_until_timestamp(uint32_t timestamp) {
+    uint32_t now = watch_rtc_get_unix_time();
+    if ((int32_t)(timestamp - now) <= 0) return 1;
+
+    // the multiplication below would wrap for deadlines more than a year or so out. wait as long as a timer can
+    // instead; the deadline isn't due when that fires, so the caller just re-arms for what's left.
+    uint32_t freq = watch_rtc_get_frequency();
+    if (timestamp - now > INT32_MAX / freq) return INT32_MAX;
+
+    // the second changes when the counter's subsecond bits pass 64 (see watch_rtc_set_unix_time), so count
+    // whole seconds from the start of this one; that lines the wakeup up with the 1 Hz tick.
+    rtc_counter_t into_second = (watch_rtc_get_counter() - freq / 2) & (freq - 1);
+
+    return (timestamp - now) * freq - into_second;
+}
+
+static inline bool _movement_background_task_before(const movement_background_task_t *a, const movement_background_task_t *b) {
+    return a->timestamp < b->timestamp;
+}
+
+static void _movement_background_task_sift_up(uint8_t index) {
+    movement_background_task_t task = _movement_background_tasks[index];
+
+    while (index > 0) {
+        uint8_t parent = (index - 1) / 2;
+        if (!_movement_background_task_before(&task, &_movement_background_tasks[parent])) break;
+        _movement_background_tasks[index] = _movement_background_tasks[parent];
+        index = parent;
+    }
+
+    _movement_background_tasks[index] = task;
+}
+
+static void _movement_background_task_sift_down(uint8_t index) {
+    movement_background_task_t task = _movement_background_tasks[index];
+
+    while (true) {
+        uint8_t child = index * 2 + 1;
+        if (child >= _movement_num_background_tasks) break;
+        if (child + 1 < _movement_num_background_tasks && _movement_background_task_before(&_movement_background_tasks[child + 1], &_movement_background_tasks[child])) child++;
+        if (!_movement_background_task_before(&_movement_background_tasks[child], &task)) break;
+        _movement_background_tasks[index] = _movement_background_tasks[child];
+        index = child;
+    }
+
+    _movement_background_tasks[index] = task;
+}
+
+static void _movement_background_task_remove_at(uint8_t index) {
+    if (_movement_background_tasks[index].keep_awake) _movement_num_keep_awake_tasks--;
+    _movement_num_background_tasks--;
+    if (index == _movement_num_background_tasks) return;
+
+    _movement_background_tasks[index] = _movement_background_tasks[_movement_num_background_tasks];
+    _movement_background_task_sift_up(index);
+    _movement_background_task_sift_down(index);
+}
+
+static int16_t _movement_background_task_find(uint8_t watch_face_index, uint8_t task_id) {
+    // the heap isn't ordered by owner, but there are only ever a handful of tasks.
+    for (uint8_t i = 0; i < _movement_num_background_tasks; i++) {
+        if (_movement_background_tasks[i].watch_face_index == watch_face_index && _movement_background_tasks[i].task_id == task_id) return i;
+    }
+
+    return -1;
+}
+
+static void _movement_handle_background_tasks(void *context);
+
+static void _movement_schedule_next_background_task(void) {
+    if (_movement_num_background_tasks) {
+        uint32_t delay = _movement_ticks_until_timestamp(_movement_background_tasks[0].timestamp);
+        _movement_timer_start(&_movement_background_task_timer, delay, 0, _movement_handle_background_tasks, NULL);
+    } else {
+        movement_timer_stop(&_movement_background_task_timer);
+    }
+}
+
+static void _movement_handle_background_tasks(void *context) {
+    (void) context;
+    uint32_t now = watch_rtc_get_unix_time();
+
+    // a deadline too far out for one timer (stopwatch_face's distant_future, say) fires early with nothing due;
+    // rescheduling below covers the rest of the distance. a task the face schedules from its loop is in the
+    // future, so this always ends.
+    while (_movement_num_background_tasks && _movement_background_tasks[0].timestamp <= now) {
+        _movement_current_background_task = _movement_background_tasks[0];
+        _movement_background_task_remove_at(0);
+
+        uint8_t i = _movement_current_background_task.watch_face_index;
+        movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
+        watch_faces[i].loop(background_event, watch_face_contexts[i]);
+    }
+
+    _movement_schedule_next_background_task();
+}
+
+static bool _movement_schedule_background_task(uint8_t watch_face_index, uint8_t task_id, uint32_t timestamp, uint32_t payload, bool keep_awake) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES || timestamp <= watch_rtc_get_unix_time()) return false;
+
+    int16_t index = _movement_background_task_find(watch_face_index, task_id);
+    if (index < 0) {
+        if (_movement_num_background_tasks >= MOVEMENT_MAX_BACKGROUND_TASKS) return false;
+        index = _movement_num_background_tasks++;
+    } else if (_movement_background_tasks[index].keep_awake) {
+        _movement_num_keep_awake_tasks--;
+    }
+
+    _movement_background_tasks[index] = (movement_background_task_t) {
+        .timestamp = timestamp,
+        .payload = payload,
+        .watch_face_index = watch_face_index,
+        .task_id = task_id,
+        .keep_awake = keep_awake,
+    };
+    if (keep_awake) _movement_num_keep_awake_tasks++;
+    _movement_background_task_sift_up(index);
+    _movement_background_task_sift_down(index);
+    _movement_schedule_next_background_task();
+
+    return true;
+}
+
+bool movement_schedule_background_task_with_id(uint8_t watch_face_index, uint8_t task_id, uint32_t timestamp, uint32_t payload) {
+    return _movement_schedule_background_task(watch_face_index, task_id, timestamp, payload, false);
+}
+
+void movement_cancel_background_task_with_id(uint8_t watch_face_index, uint8_t task_id) {
+    int16_t index = _movement_background_task_find(watch_face_index, task_id);
+    if (index < 0) return;
+
+    _movement_background_task_remove_at(index);
+    _movement_schedule_next_background_task();
+}
+
+uint8_t movement_get_background_task_id(void) {
+    return _movement_current_background_task.task_id;
+}
+
+uint32_t movement_get_background_task_payload(void) {
+    return _movement_current_background_task.payload;
+}
+
+void movement_schedule_wakeup_for_face(uint8_t watch_face_index, uint32_t timestamp) {
+    movement_schedule_background_task_with_id(watch_face_index, 0, timestamp, 0);
+}
+
+void movement_cancel_wakeup_for_face(uint8_t watch_face_index) {
+    movement_cancel_background_task_with_id(watch_face_index, 0);
+}
+
 void movement_illuminate_led(void) {
     if (movement_state.settings.bit.led_duration != 0b111) {
         movement_state.light_on = true;
@@ -529,23 +831,11 @@ void movement_cancel_background_task(void) {
 }
 
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time) {
-    watch_date_time_t now = watch_rtc_get_date_time();
-    if (date_time.reg > now.reg) {
-        movement_state.has_scheduled_background_task = true;
-        scheduled_tasks[watch_face_index].reg = date_time.reg;
-    }
+    _movement_schedule_background_task(watch_face_index, 0, watch_utility_date_time_to_unix_time(date_time, 0), 0, true);
 }
 
 void movement_cancel_background_task_for_face(uint8_t watch_face_index) {
-    scheduled_tasks[watch_face_index].reg = 0;
-    bool other_tasks_scheduled = false;
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg != 0) {
-            other_tasks_scheduled = true;
-            break;
-        }
-    }
-    movement_state.has_scheduled_background_task = other_tasks_scheduled;
+    movement_cancel_background_task_with_id(watch_face_index, 0);
 }
 
 void movement_request_sleep(void) {
@@ -645,15 +935,12 @@ uint8_t movement_claim_backup_register(void) {
 }
 
 int32_t movement_get_current_timezone_offset_for_zone(uint8_t zone_index) {
-    int8_t cached_dst_offset = _movement_dst_offset_cache[zone_index];
+    // we've precalculated the offset for this zone and can return it.
+    return (int32_t)_movement_dst_offset_cache[zone_index] * 15 * 60;
+}
 
-    if (cached_dst_offset == TIMEZONE_DOES_NOT_OBSERVE) {
-        // if time zone doesn't observe DST, we can just return the standard time offset from the zone definition.
-        return (int32_t)zone_defns[zone_index].offset_inc_minutes * OFFSET_INCREMENT * 60;
-    } else {
-        // otherwise, we've precalculated the offset for this zone and can return it.
-        return (int32_t)cached_dst_offset * OFFSET_INCREMENT * 60;
-    }
+int32_t movement_get_timezone_offset_for_zone_at(uint8_t zone_index, uint32_t timestamp) {
+    return (int32_t)tz_transitions_offset_at(zone_index, timestamp, NULL) * 15 * 60;
 }
 
 int32_t movement_get_current_timezone_offset(void) {
@@ -712,11 +999,16 @@ void movement_set_utc_timestamp(uint32_t timestamp) {
 
     // If the time was changed, the top of the minute alarm needs to be reset accordingly
     _movement_set_top_of_minute_alarm();
-
-    // this may seem wasteful, but if the user's local time is in a zone that observes DST,
-    // they may have just crossed a DST boundary, which means the next call to this function
-    // could require a different offset to force local time back to UTC. Quelle horreur!
-    _movement_update_dst_offset_cache();
+    // and so does the timer for the next background task.
+    _movement_schedule_next_background_task();
+
+    // if the user's local time is in a zone that observes DST, they may have just crossed a DST
+    // boundary, which means the next call to this function could require a different offset to
+    // force local time back to UTC. Quelle horreur! Small adjustments that stay clear of every
+    // transition leave the cache as it is, though.
+    if (timestamp < _movement_dst_cache_valid_from || timestamp >= _movement_dst_earliest_transition) {
+        _movement_update_dst_offset_cache();
+    }
 }
 
 
@@ -806,11 +1098,60 @@ void movement_set_backlight_dwell(uint8_t value) {
 }
 
 void movement_store_settings(void) {
-    movement_settings_t old_settings;
-    filesystem_read_file("settings.u32", (char *)&old_settings, sizeof(movement_settings_t));
-    if (movement_state.settings.reg != old_settings.reg) {
-        filesystem_write_file("settings.u32", (char *)&movement_state.settings, sizeof(movement_settings_t));
+    movement_kv_put(MOVEMENT_KV_SETTINGS, movement_state.settings.reg);
+}
+
+bool movement_kv_get(uint16_t key, uint32_t *value) {
+    // a value that hasn't been flushed yet is newer than the one on disk.
+    for (uint8_t i = 0; i < _movement_kv_queue_length; i++) {
+        if (_movement_kv_queue_keys[i] == key) {
+            *value = _movement_kv_queue_values[i];
+            return true;
+        }
+    }
+
+    return filesystem_kv_get(key, value);
+}
+
+static void _movement_kv_flush_timer_fired(void *context) {
+    (void) context;
+    movement_kv_flush();
+}
+
+bool movement_kv_put(uint16_t key, uint32_t value) {
+    uint8_t i;
+
+    for (i = 0; i < _movement_kv_queue_length; i++) {
+        if (_movement_kv_queue_keys[i] == key) break;
+    }
+    if (i == MOVEMENT_KV_QUEUE_SIZE) {
+        if (!movement_kv_flush()) return false;
+        i = 0;
+    }
+    if (i == _movement_kv_queue_length) _movement_kv_queue_length++;
+
+    _movement_kv_queue_keys[i] = key;
+    _movement_kv_queue_values[i] = value;
+
+    if (!_movement_kv_flush_timer.heap_slot) {
+        _movement_timer_start(&_movement_kv_flush_timer, MOVEMENT_KV_FLUSH_DELAY * watch_rtc_get_frequency(), 0, _movement_kv_flush_timer_fired, NULL);
+    }
+
+    return true;
+}
+
+bool movement_kv_flush(void) {
+    if (_movement_kv_queue_length == 0) return true;
+
+    movement_timer_stop(&_movement_kv_flush_timer);
+    if (!filesystem_kv_put_many(_movement_kv_queue_keys, _movement_kv_queue_values, _movement_kv_queue_length)) {
+        // keep the queue and try again later rather than dropping every setting in it.
+        _movement_timer_start(&_movement_kv_flush_timer, MOVEMENT_KV_FLUSH_DELAY * watch_rtc_get_frequency(), 0, _movement_kv_flush_timer_fired, NULL);
+        return false;
     }
+    _movement_kv_queue_length = 0;
+
+    return true;
 }
 
 bool movement_alarm_enabled(void) {
@@ -898,25 +1239,34 @@ bool movement_set_accelerometer_motion_threshold(uint8_t new_threshold) {
 }
 
 float movement_get_temperature(void) {
-    float temperature_c = (float)0xFFFFFFFF;
+    int16_t temperature_centi = movement_get_temperature_centi();
+
+    if (temperature_centi == MOVEMENT_TEMPERATURE_UNAVAILABLE) return (float)0xFFFFFFFF;
+
+    return temperature_centi / 100.0f;
+}
+
+int16_t movement_get_temperature_centi(void) {
+    int16_t temperature_centi = MOVEMENT_TEMPERATURE_UNAVAILABLE;
 #if __EMSCRIPTEN__
-    temperature_c = EM_ASM_DOUBLE({
-        return temp_c || 25.0;
+    temperature_centi = EM_ASM_INT({
+        return Math.round((temp_c || 25.0) * 100);
     });
 #else
 
     if (movement_state.has_thermistor) {
         thermistor_driver_enable();
-        temperature_c = thermistor_driver_get_temperature();
+        temperature_centi = thermistor_driver_get_temperature_centi();
         thermistor_driver_disable();
     } else if (movement_state.has_lis2dw) {
             int16_t val = lis2dw_get_temperature();
             val = val >> 4;
-            temperature_c = 25 + (float)val / 16.0;
+            // 25°C plus sixteenths of a degree.
+            temperature_centi = 2500 + val * 25 / 4;
     }
 #endif
 
-    return temperature_c;
+    return temperature_centi;
 }
 
 void app_init(void) {
@@ -971,13 +1321,12 @@ void app_init(void) {
 
     movement_state.has_thermistor = thermistor_driver_init();
 
-    bool settings_file_exists = filesystem_file_exists("settings.u32");
+    // settings used to be stored in a file of their own; if that's still around, move it into the key-value store.
+    filesystem_kv_import_file(MOVEMENT_KV_SETTINGS, "settings.u32");
     movement_settings_t maybe_settings;
-    if (settings_file_exists && maybe_settings.bit.version == 0) {
-        filesystem_read_file("settings.u32", (char *) &maybe_settings, sizeof(movement_settings_t));
-    }
+    bool settings_exist = movement_kv_get(MOVEMENT_KV_SETTINGS, &maybe_settings.reg);
 
-    if (settings_file_exists && maybe_settings.bit.version == 0) {
+    if (settings_exist && maybe_settings.bit.version == 0) {
         // If settings file exists and has a valid version, restore it!
         movement_state.settings.reg = maybe_settings.reg;
     } else {
@@ -1058,7 +1407,6 @@ void app_setup(void) {
 
         for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
             watch_face_contexts[i] = NULL;
-            scheduled_tasks[i].reg = 0;
             is_first_launch = false;
         }
 
@@ -1152,6 +1500,9 @@ void app_setup(void) {
         }
 
         watch_faces[movement_state.current_face_idx].activate(watch_face_contexts[movement_state.current_face_idx]);
+#ifdef WATCH_HOST
+        watch_host_energy_set_face(movement_state.current_face_idx, (void (*)(void))watch_faces[movement_state.current_face_idx].setup);
+#endif
         movement_volatile_state.pending_events |=  1 << EVENT_ACTIVATE;
     }
 }
@@ -1170,16 +1521,27 @@ static void _sleep_mode_app_loop(void) {
         }
 
         // we also have to handle top-of-the-minute tasks here in the mini-runloop
+        bool minute_handled = false;
         if (movement_volatile_state.minute_alarm_fired) {
             movement_volatile_state.minute_alarm_fired = false;
             _movement_renew_top_of_minute_alarm();
             _movement_handle_top_of_minute();
+            minute_handled = true;
+        }
+
+        // ...and any software timers that came due
+        if (movement_volatile_state.timer_fired) {
+            movement_volatile_state.timer_fired = false;
+            _movement_handle_timers();
         }
 
-        movement_event_t event;
-        event.event_type = EVENT_LOW_ENERGY_UPDATE;
-        event.subsecond = 0;
-        watch_faces[movement_state.current_face_idx].loop(event, watch_face_contexts[movement_state.current_face_idx]);
+        // faces treat EVENT_LOW_ENERGY_UPDATE as once a minute, so a timer or background task waking us doesn't send it.
+        if (minute_handled) {
+            movement_event_t event;
+            event.event_type = EVENT_LOW_ENERGY_UPDATE;
+            event.subsecond = 0;
+            watch_faces[movement_state.current_face_idx].loop(event, watch_face_contexts[movement_state.current_face_idx]);
+        }
 
         // If any of the previous loops requested to wake up, do it!
         if (movement_volatile_state.exit_sleep_mode) {
@@ -1206,6 +1568,8 @@ static bool _switch_face(void) {
     const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
 
     wf->resign(watch_face_contexts[movement_state.current_face_idx]);
+    // whatever the face saved while it was up, write it out now.
+    movement_kv_flush();
     movement_state.current_face_idx = movement_state.next_face_idx;
     // we have just updated the face idx, so we must recache the watch face pointer.
     wf = &watch_faces[movement_state.current_face_idx];
@@ -1218,6 +1582,9 @@ static bool _switch_face(void) {
     }
 
     wf->activate(watch_face_contexts[movement_state.current_face_idx]);
+#ifdef WATCH_HOST
+    watch_host_energy_set_face(movement_state.current_face_idx, (void (*)(void))wf->setup);
+#endif
 
     movement_event_t event;
     event.subsecond = 0;
@@ -1265,13 +1632,19 @@ bool app_loop(void) {
     // handle any button up/down events that occurred, e.g. schedule longpress timeouts, reset inactivity, etc.
     _movement_handle_button_presses(pending_events);
 
-    // if we have a scheduled background task, handle that here:
+    // a face that scheduled a background task the old way expects to stay awake until it fires.
     if (
         (pending_events & (1 << EVENT_TICK))
         && event.subsecond == 0
-        && movement_state.has_scheduled_background_task
+        && _movement_num_keep_awake_tasks
     ) {
-        _movement_handle_scheduled_tasks();
+        _movement_reset_inactivity_countdown();
+    }
+
+    // run the callbacks of any software timers that came due
+    if (movement_volatile_state.timer_fired) {
+        movement_volatile_state.timer_fired = false;
+        _movement_handle_timers();
     }
 
     // Pop the EVENT_TIMEOUT out of the pending_events so it can be handled separately
@@ -1329,6 +1702,9 @@ bool app_loop(void) {
         // No need to fire resign and sleep interrupts while in sleep mode
         _movement_disable_inactivity_countdown();
 
+        // and no reason to keep unsaved settings around while we sleep.
+        movement_kv_flush();
+
         watch_register_extwake_callback(HAL_GPIO_BTN_ALARM_pin(), cb_alarm_btn_extwake, true);
 
         // _sleep_mode_app_loop takes over at this point and loops until exit_sleep_mode is set by the extwake handler,
@@ -1519,6 +1895,14 @@ void cb_minute_alarm_fired(void) {
 #endif
 }
 
+void cb_timer_fired(void) {
+    movement_volatile_state.timer_fired = true;
+
+#if __EMSCRIPTEN__
+    _wake_up_simulator();
+#endif
+}
+
 void cb_tick(void) {
     rtc_counter_t counter = watch_rtc_get_counter();
     uint32_t freq = watch_rtc_get_frequency();
@@ -150,6 +150,7 @@ typedef enum {
     RESIGN_TIMEOUT,             // Resign active face timeout
     SLEEP_TIMEOUT,              // Low-energy begin timeout
     MINUTE_TIMEOUT,             // Top of the Minute timeout
+    TIMER_TIMEOUT,              // Earliest software timer, see movement_timer_start
 } movement_timeout_index_t;
 
 typedef enum {
@@ -277,9 +278,6 @@ typedef struct {
     // LED stuff
     bool light_on;
 
-    // background task handling
-    bool has_scheduled_background_task;
-
     // stuff for subsecond tracking
     uint8_t tick_frequency;
     uint8_t tick_pern;
@@ -316,6 +314,33 @@ void movement_force_led_off(void);
 
 void movement_request_tick_frequency(uint8_t freq);
 
+// Software timers, for watch faces that need to wake up at a precise moment (or at a steady interval)
+// without raising the tick frequency. All running timers share one RTC compare slot; Movement keeps
+// them in a min-heap ordered by deadline, so starting or stopping one is O(log n) and finding the next
+// deadline is O(1). At most MOVEMENT_MAX_TIMERS can run at once.
+#define MOVEMENT_MAX_TIMERS 16
+
+// The callback is invoked from the run loop, not from the interrupt, so it may do anything a watch face's
+// loop can do. It may also restart or stop this or any other timer.
+typedef void (*movement_timer_cb_t)(void *context);
+
+// The storage for a timer belongs to the caller, typically in a watch face's context. A zeroed timer is a
+// stopped timer; leave the fields alone and use the functions below.
+typedef struct {
+    rtc_counter_t deadline;
+    uint32_t period;
+    movement_timer_cb_t callback;
+    void *context;
+    uint8_t heap_slot; // position in the heap plus one, or 0 if the timer isn't running
+} movement_timer_t;
+
+// Starts (or restarts) a timer that fires delay_ticks from now, and then every period_ticks if period_ticks
+// is nonzero. Ticks are 1/128 of a second; use watch_rtc_get_frequency() to convert from seconds.
+// Returns false if MOVEMENT_MAX_TIMERS are already running.
+bool movement_timer_start(movement_timer_t *timer, uint32_t delay_ticks, uint32_t period_ticks, movement_timer_cb_t callback, void *context);
+void movement_timer_stop(movement_timer_t *timer);
+bool movement_timer_is_running(movement_timer_t *timer);
+
 // note: watch faces can only schedule a background task when in the foreground, since
 // movement will associate the scheduled task with the currently active face.
 void movement_schedule_background_task(watch_date_time_t date_time);
@@ -325,9 +350,32 @@ void movement_schedule_background_task(watch_date_time_t date_time);
 void movement_cancel_background_task(void);
 
 // these functions should work around the limitation of the above functions, which will be deprecated.
+// A task scheduled with any of these four is task ID 0 below, and keeps the watch out of low energy mode
+// until it fires or is cancelled.
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time);
 void movement_cancel_background_task_for_face(uint8_t watch_face_index);
 
+// Background tasks: rather than asking every minute via advise() whether it has anything to do, a watch face
+// can tell Movement the UTC timestamp of its next piece of work. Movement wakes up just for that (from the RTC
+// compare interrupt, so this works in low energy mode too) and sends the face an EVENT_BACKGROUND_TASK.
+// A face may have several tasks pending, told apart by a task ID of its choosing; scheduling a task with an
+// ID that is already pending replaces it. Each task fires once, and may carry a 32-bit payload that the face
+// can read back while handling the event. Task ID 0 is the one the functions above and below use.
+// Deadlines are absolute, so if yours is really a local time (like an alarm), it's on you to reschedule it
+// if the time zone changes. Returns false if the timestamp isn't in the future or too many tasks are pending.
+bool movement_schedule_background_task_with_id(uint8_t watch_face_index, uint8_t task_id, uint32_t timestamp, uint32_t payload);
+void movement_cancel_background_task_with_id(uint8_t watch_face_index, uint8_t task_id);
+
+// While handling EVENT_BACKGROUND_TASK, these tell you which task fired. Both are 0 for a background task
+// requested through advise().
+uint8_t movement_get_background_task_id(void);
+uint32_t movement_get_background_task_payload(void);
+
+// Task ID 0 above, for faces that only ever need one deadline. Unlike the date/time based functions, this
+// doesn't keep the watch awake.
+void movement_schedule_wakeup_for_face(uint8_t watch_face_index, uint32_t timestamp);
+void movement_cancel_wakeup_for_face(uint8_t watch_face_index);
+
 void movement_request_sleep(void);
 void movement_request_wake(void);
 
@@ -341,6 +389,8 @@ uint8_t movement_claim_backup_register(void);
 
 int32_t movement_get_current_timezone_offset_for_zone(uint8_t zone_index);
 int32_t movement_get_current_timezone_offset(void);
+// The offset of any zone at any UTC timestamp from 2020 through 2083, in seconds, past DST changes and all.
+int32_t movement_get_timezone_offset_for_zone_at(uint8_t zone_index, uint32_t timestamp);
 
 int32_t movement_get_timezone_index(void);
 void movement_set_timezone_index(uint8_t value);
@@ -386,6 +436,21 @@ void movement_set_backlight_dwell(uint8_t value);
 
 void movement_store_settings(void);
 
+// A small key-value store for 32-bit values like the ones above that should survive a reset. Keys are 16 bits;
+// Movement's own are below, and faces that can have several instances add their instance number to theirs.
+// Storing the value a key already has is free, so you don't need to check first.
+#define MOVEMENT_KV_SETTINGS            0x0001
+#define MOVEMENT_KV_LOCATION            0x0002
+#define MOVEMENT_KV_WORLD_CLOCK_BASE    0x0100
+#define MOVEMENT_KV_DAYS_SINCE_BASE     0x0200
+
+// Puts don't hit the flash right away: Movement holds them in RAM and writes them all in one commit when the face
+// resigns, before the watch enters low energy mode, or 30 seconds after the first one. Call movement_kv_flush to
+// write them out now, say before a reset. If the write fails they stay queued and are retried 30 seconds later.
+bool movement_kv_get(uint16_t key, uint32_t *value);
+bool movement_kv_put(uint16_t key, uint32_t value);
+bool movement_kv_flush(void);
+
 /// TODO: For #SecondMovement: Should we have a counter that watch faces increment when they enable an alarm, and decrement when they disable it?
 /// Or should there be a watch face function where watch faces can tell us if they have an alarm enabled?
 /// Worth considering a better way to handle this.
@@ -408,3 +473,8 @@ bool movement_set_accelerometer_motion_threshold(uint8_t new_threshold);
 // If the board has multiple temperature sensors, it will use the most accurate one available.
 // If the board has no temperature sensors, it will return 0xFFFFFFFF.
 float movement_get_temperature(void);
+
+// The same, in hundredths of a degree celsius, and without any floating point math on the way. If the board has
+// no temperature sensors, it will return MOVEMENT_TEMPERATURE_UNAVAILABLE.
+#define MOVEMENT_TEMPERATURE_UNAVAILABLE (INT16_MIN)
+int16_t movement_get_temperature_centi(void);
@@ -60,6 +60,26 @@ static size_t s_buf_len = 0;
 // Pointer to the first invalid byte after the end of input.
 static char *const s_buf_end = s_buf + SHELL_BUF_SZ;
 
+// A small ring of recent commands, browsed with the up and down arrows.
+// Commands too long for a slot aren't saved.
+#define SHELL_HISTORY_LEN  (4)
+#define SHELL_HISTORY_LINE_SZ  (64)
+static char s_history[SHELL_HISTORY_LEN][SHELL_HISTORY_LINE_SZ] = {0};
+// Number of commands ever saved; the newest is at (s_history_count - 1).
+static size_t s_history_count = 0;
+// How many commands back we are while browsing; 0 is the line being typed.
+static size_t s_history_pos = 0;
+
+// Progress through a key's escape sequence: ESC [ A for the arrows, but also
+// ESC [ 3 ~ for Delete, ESC O H for Home and so on, which we swallow whole.
+typedef enum {
+    SHELL_ESCAPE_NONE = 0,
+    SHELL_ESCAPE_ESC,
+    SHELL_ESCAPE_CSI,
+    SHELL_ESCAPE_SS3,
+} shell_escape_state_t;
+static shell_escape_state_t s_escape_state = SHELL_ESCAPE_NONE;
+
 static char *prv_skip_whitespace(char *c) {
     while (c >= s_buf && c < s_buf_end) {
         if (*c == 0) {
@@ -99,6 +119,53 @@ static char *prv_skip_non_whitespace(char *c) {
     return NULL;
 }
 
+// g_shell_commands is sorted by name, ignoring case, so we can binary search
+// it for a command, and all the commands sharing a prefix sit together.
+static size_t prv_first_with_prefix(const char *prefix, size_t len) {
+    size_t low = 0;
+    size_t high = g_num_shell_commands;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (strncasecmp(g_shell_commands[middle].name, prefix, len) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static const shell_command_t *prv_find_command(const char *name) {
+    size_t low = 0;
+    size_t high = g_num_shell_commands;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        int cmp = strcasecmp(g_shell_commands[middle].name, name);
+        if (cmp == 0) {
+            return &g_shell_commands[middle];
+        }
+        if (cmp < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return NULL;
+}
+
+#ifndef NDEBUG
+// The binary searches above quietly miss commands if g_shell_commands falls
+// out of order, so complain about it as soon as the shell starts.
+static void prv_check_command_order(void) {
+    for (size_t i = 1; i < g_num_shell_commands; i++) {
+        if (strcasecmp(g_shell_commands[i - 1].name, g_shell_commands[i].name) >= 0) {
+            printf("shell: commands out of order: %s before %s" NEWLINE,
+                   g_shell_commands[i - 1].name, g_shell_commands[i].name);
+        }
+    }
+}
+#endif
+
 static int prv_handle_command() {
     char *argv[SHELL_MAX_ARGS] = {0};
     int argc = 0;
@@ -132,33 +199,186 @@ static int prv_handle_command() {
         return -1;
     }
 
-    // Match against the command list
-    for (size_t i = 0; i < g_num_shell_commands; i++) {
-        if (!strcasecmp(g_shell_commands[i].name, argv[0])) {
-            // If argc isn't valid for this command, display its help instead.
-            if (((argc - 1) < g_shell_commands[i].min_args) ||
-                ((argc - 1) > g_shell_commands[i].max_args)) {
-                if (g_shell_commands[i].help != NULL) {
-                    printf(NEWLINE "%s" NEWLINE, g_shell_commands[i].help);
-                }
-                return -2;
-            }
-            // Call the command's callback
-            if (g_shell_commands[i].cb != NULL) {
-                printf(NEWLINE);
-                int ret = g_shell_commands[i].cb(argc, argv);
-                if (ret == -2) {
-                    printf(NEWLINE "%s" NEWLINE, g_shell_commands[i].help);
-                }
-                return ret;
-            }
+    const shell_command_t *command = prv_find_command(argv[0]);
+    if (command == NULL) {
+        return -1;
+    }
+
+    // If argc isn't valid for this command, display its help instead.
+    if (((argc - 1) < command->min_args) ||
+        ((argc - 1) > command->max_args)) {
+        if (command->help != NULL) {
+            printf(NEWLINE "%s" NEWLINE, command->help);
+        }
+        return -2;
+    }
+    // Call the command's callback
+    if (command->cb != NULL) {
+        printf(NEWLINE);
+        int ret = command->cb(argc, argv);
+        if (ret == -2) {
+            printf(NEWLINE "%s" NEWLINE, command->help);
         }
+        return ret;
     }
 
     return -1;
 }
 
+#if !__EMSCRIPTEN__
+static void prv_history_add(void) {
+    if (s_buf_len == 0 || s_buf_len >= SHELL_HISTORY_LINE_SZ) {
+        return;
+    }
+
+    // Don't fill the ring with the same command run over and over.
+    if (s_history_count > 0) {
+        const char *last = s_history[(s_history_count - 1) % SHELL_HISTORY_LEN];
+        if (strlen(last) == s_buf_len && !memcmp(last, s_buf, s_buf_len)) {
+            return;
+        }
+    }
+
+    char *line = s_history[s_history_count % SHELL_HISTORY_LEN];
+    memcpy(line, s_buf, s_buf_len);
+    line[s_buf_len] = '\0';
+    s_history_count++;
+}
+
+// Erase the line on screen and in the buffer, and type this one instead.
+static void prv_replace_line(const char *line, size_t len) {
+    while (s_buf_len > 0) {
+        printf("\b \b");
+        s_buf_len--;
+    }
+    memcpy(s_buf, line, len);
+    s_buf_len = len;
+    printf("%.*s", (int) len, line);
+}
+
+// Step back (older) or forward (newer) through the history.
+static void prv_history_browse(bool older) {
+    size_t saved = (s_history_count < SHELL_HISTORY_LEN) ? s_history_count : SHELL_HISTORY_LEN;
+
+    if (older && s_history_pos < saved) {
+        s_history_pos++;
+    } else if (!older && s_history_pos > 0) {
+        s_history_pos--;
+    } else {
+        return;
+    }
+
+    if (s_history_pos == 0) {
+        prv_replace_line("", 0);
+    } else {
+        const char *line = s_history[(s_history_count - s_history_pos) % SHELL_HISTORY_LEN];
+        prv_replace_line(line, strlen(line));
+    }
+}
+
+// Complete the command name being typed: all the way if only one command
+// matches, otherwise as far as the matches agree, listing them if that's
+// no further than what's been typed.
+static void prv_complete(void) {
+    if (memchr(s_buf, ' ', s_buf_len) != NULL) {
+        // Only the command name is completed.
+        return;
+    }
+
+    size_t first = prv_first_with_prefix(s_buf, s_buf_len);
+    size_t last = first;
+    while (last < g_num_shell_commands &&
+           !strncasecmp(g_shell_commands[last].name, s_buf, s_buf_len)) {
+        last++;
+    }
+    if (first == last) {
+        return;
+    }
+
+    const char *name = g_shell_commands[first].name;
+    size_t len = s_buf_len;
+    while (name[len] != '\0') {
+        bool shared = true;
+        for (size_t i = first + 1; i < last && shared; i++) {
+            shared = tolower((int) g_shell_commands[i].name[len]) == tolower((int) name[len]);
+        }
+        if (!shared) {
+            break;
+        }
+        len++;
+    }
+
+    if (len == s_buf_len && last - first > 1) {
+        printf(NEWLINE);
+        for (size_t i = first; i < last; i++) {
+            printf("%s  ", g_shell_commands[i].name);
+        }
+        printf(NEWLINE SHELL_PROMPT "%.*s", (int) s_buf_len, s_buf);
+        return;
+    }
+
+    for (; s_buf_len < len && s_buf_len < SHELL_BUF_SZ - 2; s_buf_len++) {
+        s_buf[s_buf_len] = name[s_buf_len];
+        putchar(name[s_buf_len]);
+    }
+    if (last - first == 1 && s_buf_len < SHELL_BUF_SZ - 2) {
+        s_buf[s_buf_len++] = ' ';
+        putchar(' ');
+    }
+}
+
+// Returns true if c was part of an escape sequence.
+static bool prv_handle_escape(int c) {
+    switch (s_escape_state) {
+        case SHELL_ESCAPE_NONE:
+            if (c != 0x1b) {
+                return false;
+            }
+            s_escape_state = SHELL_ESCAPE_ESC;
+            return true;
+        case SHELL_ESCAPE_ESC:
+            if (c == '[') {
+                s_escape_state = SHELL_ESCAPE_CSI;
+            } else if (c == 'O') {
+                s_escape_state = SHELL_ESCAPE_SS3;
+            } else {
+                s_escape_state = SHELL_ESCAPE_NONE;
+            }
+            return true;
+        case SHELL_ESCAPE_CSI:
+            if (c >= 0x20 && c <= 0x3f) {
+                // parameter and intermediate bytes, like the 3 in ESC [ 3 ~.
+                return true;
+            }
+            s_escape_state = SHELL_ESCAPE_NONE;
+            if (c < 0x40 || c > 0x7e) {
+                // not a valid sequence; let the caller have this one.
+                return false;
+            }
+            if (c == 'A') {
+                prv_history_browse(true);
+            } else if (c == 'B') {
+                prv_history_browse(false);
+            }
+            return true;
+        case SHELL_ESCAPE_SS3:
+            s_escape_state = SHELL_ESCAPE_NONE;
+            return true;
+    }
+
+    return false;
+}
+#endif
+
 void shell_task(void) {
+#ifndef NDEBUG
+    static bool s_checked_command_order = false;
+    if (!s_checked_command_order) {
+        s_checked_command_order = true;
+        prv_check_command_order();
+    }
+#endif
+
 #if __EMSCRIPTEN__
     // This is a terrible hack; ideally this should be handled deeper in the watch library.
     // Alas, emscripten treats read() as something that should pop up an input box, so I
@@ -197,6 +417,15 @@ void shell_task(void) {
             break;
         }
 
+        if (prv_handle_escape(c)) {
+            continue;
+        }
+
+        if (c == '\t') {
+            prv_complete();
+            continue;
+        }
+
         if (c == '\b') {
             // Handle backspace character.
             // We need to emit a backspace, overwrite the character on the
@@ -216,6 +445,8 @@ void shell_task(void) {
         if (c == '\n' || c == '\r') {
             // Newline! Handle the command.
             s_buf[s_buf_len+1] = '\0';
+            prv_history_add();
+            s_history_pos = 0;
             (void) prv_handle_command();
             s_buf_len = 0;
             printf(NEWLINE SHELL_PROMPT);
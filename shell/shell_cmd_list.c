@@ -29,13 +29,17 @@
 #include <stdlib.h>
 
 #include "filesystem.h"
+#include "movement.h"
 #include "watch.h"
 #include "delay.h"
+#include "totp_db.h"
 
 static int help_cmd(int argc, char *argv[]);
 static int flash_cmd(int argc, char *argv[]);
 static int stress_cmd(int argc, char *argv[]);
 
+// Keep this sorted by name, ignoring case: the shell binary searches it, and
+// completes command names from it.
 shell_command_t g_shell_commands[] = {
     {
         .name = "?",
@@ -45,11 +49,32 @@ shell_command_t g_shell_commands[] = {
         .cb = help_cmd,
     },
     {
-        .name = "help",
-        .help = "print command list",
+        .name = "b64encode",
+        .help = "usage: b64encode <PATH>",
+        .min_args = 1,
+        .max_args = 1,
+        .cb = filesystem_cmd_b64encode,
+    },
+    {
+        .name = "cat",
+        .help = "usage: cat <PATH>",
+        .min_args = 1,
+        .max_args = 1,
+        .cb = filesystem_cmd_cat,
+    },
+    {
+        .name = "df",
+        .help = "print filesystem free space",
         .min_args = 0,
         .max_args = 0,
-        .cb = help_cmd,
+        .cb = filesystem_cmd_df,
+    },
+    {
+        .name = "echo",
+        .help = "usage: echo TEXT {>,>>} FILE",
+        .min_args = 3,
+        .max_args = 3,
+        .cb = filesystem_cmd_echo,
     },
     {
         .name = "flash",
@@ -59,53 +84,46 @@ shell_command_t g_shell_commands[] = {
         .cb = flash_cmd,
     },
     {
-        .name = "ls",
-        .help = "usage: ls [PATH]",
-        .min_args = 0,
-        .max_args = 1,
-        .cb = filesystem_cmd_ls,
-    },
-    {
-        .name = "cat",
-        .help = "usage: cat <PATH>",
+        .name = "format",
+        .help = "usage: format YES",
         .min_args = 1,
         .max_args = 1,
-        .cb = filesystem_cmd_cat,
+        .cb = filesystem_cmd_format,
     },
     {
-        .name = "b64encode",
-        .help = "usage: b64encode <PATH>",
+        .name = "get",
+        .help = "send a file to utils/watch_file_transfer.py; usage: get <PATH>",
         .min_args = 1,
         .max_args = 1,
-        .cb = filesystem_cmd_b64encode,
+        .cb = filesystem_cmd_get,
     },
     {
-        .name = "df",
-        .help = "print filesystem free space",
+        .name = "help",
+        .help = "print command list",
         .min_args = 0,
         .max_args = 0,
-        .cb = filesystem_cmd_df,
+        .cb = help_cmd,
     },
     {
-        .name = "rm",
-        .help = "usage: rm [PATH]",
-        .min_args = 1,
+        .name = "ls",
+        .help = "usage: ls [PATH]",
+        .min_args = 0,
         .max_args = 1,
-        .cb = filesystem_cmd_rm,
+        .cb = filesystem_cmd_ls,
     },
     {
-        .name = "format",
-        .help = "usage: format YES",
-        .min_args = 1,
-        .max_args = 1,
-        .cb = filesystem_cmd_format,
+        .name = "put",
+        .help = "receive a file from utils/watch_file_transfer.py; usage: put <PATH> <SIZE>",
+        .min_args = 2,
+        .max_args = 2,
+        .cb = filesystem_cmd_put,
     },
     {
-        .name = "echo",
-        .help = "usage: echo TEXT {>,>>} FILE",
-        .min_args = 3,
-        .max_args = 3,
-        .cb = filesystem_cmd_echo,
+        .name = "rm",
+        .help = "usage: rm [PATH]",
+        .min_args = 1,
+        .max_args = 1,
+        .cb = filesystem_cmd_rm,
     },
     {
         .name = "stress",
@@ -114,6 +132,13 @@ shell_command_t g_shell_commands[] = {
         .max_args = 2,
         .cb = stress_cmd,
     },
+    {
+        .name = "totp_import",
+        .help = "rebuild totp.db for the TOTP face; usage: totp_import [PATH]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = totp_db_cmd_import,
+    },
 };
 
 const size_t g_num_shell_commands = sizeof(g_shell_commands) / sizeof(shell_command_t);
@@ -137,6 +162,8 @@ static int flash_cmd(int argc, char *argv[]) {
     (void) argc;
     (void) argv;
 
+    // don't lose any settings that are still waiting to be written.
+    movement_kv_flush();
     watch_reset_to_bootloader();
     return 0;
 }
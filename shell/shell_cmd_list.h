@@ -28,7 +28,7 @@
 #include <stdint.h>
 
 typedef struct {
-    const char *name; // Name used to invoke the command
+    const char *name; // Name used to invoke the command; see the note on g_shell_commands
     const char *help; // Help string
     int8_t min_args;  // Minimum number of arguments (_excluding_ the command name)
     int8_t max_args;  // Maximum number of arguments (_excluding_ the command name)
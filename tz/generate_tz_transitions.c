@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Build-time tool: runs on the build machine, evaluates utz's rules for every zone and prints the C source for
+// tz_zone_transitions and tz_transitions (see tz_transitions.h) to stdout. The Makefile runs this for you.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "utz.h"
+#include "zones.h"
+#include "tz_transitions.h"
+
+#define MAX_ENTRIES_PER_ZONE (8 * (TZ_TRANSITIONS_LAST_YEAR - TZ_TRANSITIONS_FIRST_YEAR + 1) + 1)
+#define MAX_ENTRIES (16384)
+
+static uint32_t entries[MAX_ENTRIES];
+static uint16_t num_entries;
+
+static int offset_at(uzone_t *zone, int64_t timestamp) {
+    // utz wants the time in the zone's standard time.
+    time_t local = (time_t)(timestamp + zone->offset.hours * 3600 + zone->offset.minutes * 60);
+    struct tm tm;
+    gmtime_r(&local, &tm);
+
+    udatetime_t udate_time = {
+        .date.year = UYEAR_FROM_YEAR(tm.tm_year + 1900),
+        .date.month = tm.tm_mon + 1,
+        .date.dayofmonth = tm.tm_mday,
+        .date.dayofweek = dayofweek(UYEAR_FROM_YEAR(tm.tm_year + 1900), tm.tm_mon + 1, tm.tm_mday),
+        .time.hour = tm.tm_hour,
+        .time.minute = tm.tm_min,
+        .time.second = tm.tm_sec,
+    };
+    uoffset_t offset;
+    get_current_offset(zone, &udate_time, &offset);
+
+    return (offset.hours * 60 + offset.minutes) / 15;
+}
+
+static uint32_t pack(int64_t timestamp, int delta) {
+    return (uint32_t)((timestamp - TZ_TRANSITIONS_EPOCH) / 900) << 8 | (uint8_t)(int8_t)delta;
+}
+
+int main(void) {
+    static uint32_t zone_entries[MAX_ENTRIES_PER_ZONE];
+
+    printf("// Generated by tz/generate_tz_transitions.c from utz's zone rules. Do not edit.\n\n");
+    printf("#include \"tz_transitions.h\"\n\n");
+    printf("const tz_zone_transitions_t tz_zone_transitions[] = {\n");
+
+    for (int i = 0; i < NUM_ZONE_NAMES; i++) {
+        uzone_t zone;
+        unpack_zone(&zone_defns[i], "", &zone);
+        int standard_offset = (zone.offset.hours * 60 + zone.offset.minutes) / 15;
+        uint16_t count = 0;
+        uint16_t first = 0;
+
+        if (zone.rules_len) {
+            // step a day at a time, which is finer than any rule set in the tz database, then find the minute.
+            int offset = offset_at(&zone, TZ_TRANSITIONS_EPOCH);
+            zone_entries[count++] = pack(TZ_TRANSITIONS_EPOCH, offset - standard_offset);
+            for (int64_t t = TZ_TRANSITIONS_EPOCH; t < TZ_TRANSITIONS_END; t += 86400) {
+                if (offset_at(&zone, t + 86400) == offset) continue;
+
+                int64_t before = t, after = t + 86400;
+                while (after - before > 60) {
+                    int64_t middle = before + ((after - before) / 120) * 60;
+                    if (offset_at(&zone, middle) == offset) before = middle;
+                    else after = middle;
+                }
+                if ((after - TZ_TRANSITIONS_EPOCH) % 900) {
+                    fprintf(stderr, "zone %d: transition at %lld isn't on a quarter hour\n", i, (long long)after);
+                    return 1;
+                }
+                if (count == MAX_ENTRIES_PER_ZONE) {
+                    fprintf(stderr, "zone %d: too many transitions\n", i);
+                    return 1;
+                }
+
+                offset = offset_at(&zone, after);
+                zone_entries[count++] = pack(after, offset - standard_offset);
+            }
+
+            // zones that change at the same instants by the same amount can share a run of entries.
+            for (first = 0; first + count <= num_entries; first++) {
+                if (!memcmp(&entries[first], zone_entries, count * sizeof(uint32_t))) break;
+            }
+            if (first + count > num_entries) {
+                if (num_entries + count > MAX_ENTRIES) {
+                    fprintf(stderr, "too many transitions\n");
+                    return 1;
+                }
+                first = num_entries;
+                memcpy(&entries[first], zone_entries, count * sizeof(uint32_t));
+                num_entries += count;
+            }
+        }
+
+        printf("    { %u, %u, %d },\n", first, count, standard_offset);
+    }
+
+    printf("};\n\n");
+    printf("const uint32_t tz_transitions[] = {\n");
+    for (uint16_t i = 0; i < num_entries; i++) {
+        printf("%s0x%08x,%s", i % 8 ? " " : "    ", entries[i], i % 8 == 7 || i == num_entries - 1 ? "\n" : "");
+    }
+    if (num_entries == 0) printf("    0\n");
+    printf("};\n");
+
+    return 0;
+}
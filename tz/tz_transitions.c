@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include "tz_transitions.h"
+
+#define TZ_TRANSITION_TIME(entry) ((entry) >> 8)
+#define TZ_TRANSITION_DELTA(entry) ((int8_t)((entry) & 0xFF))
+
+int8_t tz_transitions_offset_at(uint8_t zone_index, uint32_t timestamp, uint32_t *next_transition) {
+    const tz_zone_transitions_t *zone = &tz_zone_transitions[zone_index];
+
+    if (next_transition != NULL) *next_transition = UINT32_MAX;
+    if (zone->count == 0) return zone->standard_offset;
+
+    const uint32_t *entries = &tz_transitions[zone->first];
+    uint32_t time = timestamp < TZ_TRANSITIONS_EPOCH ? 0 : (timestamp - TZ_TRANSITIONS_EPOCH) / 900;
+
+    // find the last entry that took effect at or before this time. the first one is at the epoch, so there always is one.
+    uint16_t low = 0;
+    uint16_t high = zone->count - 1;
+    while (low < high) {
+        uint16_t middle = (low + high + 1) / 2;
+        if (TZ_TRANSITION_TIME(entries[middle]) <= time) low = middle;
+        else high = middle - 1;
+    }
+
+    if (next_transition != NULL && low + 1 < zone->count) {
+        *next_transition = TZ_TRANSITIONS_EPOCH + TZ_TRANSITION_TIME(entries[low + 1]) * 900;
+    }
+
+    return zone->standard_offset + TZ_TRANSITION_DELTA(entries[low]);
+}
@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Time zone transition tables
+ *
+ * Rather than evaluating utz's packed DST rules at runtime, the build expands them (see generate_tz_transitions.c)
+ * into a sorted list of UTC offset changes for every zone, covering every year the RTC can represent. Finding
+ * a zone's offset at any instant is then a binary search through a const table in flash.
+ *
+ * Each transition is packed into 32 bits: the upper 24 are the time it takes effect, in 15-minute units since
+ * TZ_TRANSITIONS_EPOCH; the lower 8 are the signed difference from the zone's standard offset, also in 15-minute
+ * units. A zone's first entry is at the epoch itself and holds the offset in effect at the start of the range.
+ * Zones that follow the same rules in UTC (like most of Europe) share their transitions.
+ */
+
+#define TZ_TRANSITIONS_EPOCH (1577836800)  // 2020-01-01 00:00:00 UTC, the RTC's reference year
+#define TZ_TRANSITIONS_FIRST_YEAR (2020)
+#define TZ_TRANSITIONS_LAST_YEAR (2083)
+#define TZ_TRANSITIONS_END (3597523200u)   // 2084-01-01 00:00:00 UTC, when the RTC runs out of years
+
+typedef struct {
+    uint16_t first;             // index of this zone's first entry in tz_transitions
+    uint16_t count;             // number of entries; 0 if the zone doesn't observe DST
+    int8_t standard_offset;     // in 15-minute units
+} tz_zone_transitions_t;
+
+extern const tz_zone_transitions_t tz_zone_transitions[];
+extern const uint32_t tz_transitions[];
+
+/** @brief Looks up a zone's UTC offset at a given time.
+  * @param zone_index the index of the zone, as in zone_names.
+  * @param timestamp the UTC timestamp you want the offset at.
+  * @param next_transition if not NULL, receives the UTC timestamp at which the offset next changes, or UINT32_MAX
+  *                        if it doesn't change again before the end of the table.
+  * @return the offset from UTC, in 15-minute units.
+  */
+int8_t tz_transitions_offset_at(uint8_t zone_index, uint32_t timestamp, uint32_t *next_transition);
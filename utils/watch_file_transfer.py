@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Copy files to and from a Sensor Watch over its USB serial shell.
+
+Talks to the watch's `get` and `put` commands (see filesystem_cmd_get and
+filesystem_cmd_put in filesystem/filesystem.c), which move files in binary
+chunks with a CRC-32 each, rather than base 64 encoded text.
+
+Examples:
+    # pull two logs off one watch into the current directory
+    watch_file_transfer.py get activity.dat temperature.dat --port /dev/ttyACM0
+
+    # pull them off every watch plugged in, into one directory per watch
+    watch_file_transfer.py get activity.dat temperature.dat --all --dest logs
+
+    # push a file to a watch
+    watch_file_transfer.py put totp_uris.txt --port /dev/ttyACM0
+
+Requires pyserial (pip install pyserial).
+"""
+import argparse
+import os
+import struct
+import sys
+import zlib
+from concurrent.futures import ThreadPoolExecutor
+
+import serial
+import serial.tools.list_ports
+
+SENSOR_WATCH_VID = 0x1209
+SENSOR_WATCH_PID = 0x2151
+
+ACK = 0x06
+NAK = 0x15
+CAN = 0x18
+
+MAX_RETRIES = 3
+
+
+class TransferError(Exception):
+    pass
+
+
+def read_exactly(port, length):
+    data = port.read(length)
+    if len(data) != length:
+        raise TransferError("timed out waiting for the watch")
+    return data
+
+
+def send_command(port, command):
+    """Sends a shell command and waits for the watch's ACK, skipping the shell's echo."""
+    port.reset_input_buffer()
+    # the shell runs a command on \r; a \n after it would be read as the start of the transfer.
+    port.write(command.encode() + b"\r")
+    while True:
+        c = read_exactly(port, 1)[0]
+        if c == ACK:
+            return
+        if c == NAK:
+            raise TransferError(port.readline().decode(errors="replace").strip())
+
+
+def get_file(port, path):
+    send_command(port, "get " + path)
+    size = struct.unpack("<I", read_exactly(port, 4))[0]
+    data = bytearray()
+    retries = 0
+    while len(data) < size:
+        length = struct.unpack("<H", read_exactly(port, 2))[0]
+        chunk = read_exactly(port, length)
+        crc = struct.unpack("<I", read_exactly(port, 4))[0]
+        if zlib.crc32(chunk) != crc:
+            retries += 1
+            if retries > MAX_RETRIES:
+                port.write(bytes([CAN]))
+                raise TransferError("too many bad chunks")
+            port.write(bytes([NAK]))
+            continue
+        retries = 0
+        data += chunk
+        port.write(bytes([ACK]))
+    return bytes(data)
+
+
+def put_file(port, path, data):
+    if not data:
+        # the watch takes a size of 0 for a mistyped one, and won't empty a file over it.
+        raise TransferError("empty files can't be put")
+    send_command(port, "put %s %d" % (path, len(data)))
+    chunk_size = struct.unpack("<H", read_exactly(port, 2))[0]
+    offset = 0
+    while offset < len(data):
+        chunk = data[offset:offset + chunk_size]
+        frame = struct.pack("<H", len(chunk)) + chunk + struct.pack("<I", zlib.crc32(chunk))
+        for _ in range(MAX_RETRIES + 1):
+            port.write(frame)
+            reply = read_exactly(port, 1)[0]
+            if reply != NAK:
+                break
+        if reply != ACK:
+            raise TransferError("the watch gave up on the transfer")
+        offset += len(chunk)
+
+
+def find_watches():
+    return sorted(p.device for p in serial.tools.list_ports.comports()
+                  if p.vid == SENSOR_WATCH_VID and p.pid == SENSOR_WATCH_PID)
+
+
+def transfer(device, args, dest):
+    results = []
+    with serial.Serial(device, timeout=args.timeout) as port:
+        for path in args.files:
+            try:
+                if args.command == "get":
+                    data = get_file(port, path)
+                    os.makedirs(dest, exist_ok=True)
+                    with open(os.path.join(dest, os.path.basename(path)), "wb") as f:
+                        f.write(data)
+                else:
+                    with open(path, "rb") as f:
+                        data = f.read()
+                    put_file(port, os.path.basename(path), data)
+                results.append("%s: %s: %d bytes" % (device, path, len(data)))
+            except (TransferError, OSError) as e:
+                results.append("%s: %s: %s" % (device, path, e))
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Copy files to and from a Sensor Watch over USB serial.")
+    parser.add_argument("command", choices=["get", "put"])
+    parser.add_argument("files", nargs="+", help="files on the watch to get, or local files to put")
+    parser.add_argument("--port", action="append", default=[], help="serial port of a watch; may be repeated")
+    parser.add_argument("--all", action="store_true", help="use every Sensor Watch that's plugged in")
+    parser.add_argument("--dest", default=".", help="where to save files you get (default: current directory)")
+    parser.add_argument("--timeout", type=float, default=3, help="seconds to wait for the watch (default: 3)")
+    args = parser.parse_args()
+
+    devices = args.port + (find_watches() if args.all else [])
+    if not devices:
+        parser.error("no watches; pass --port or --all")
+
+    # with several watches, keep each one's files apart.
+    def dest_for(device):
+        if len(devices) == 1:
+            return args.dest
+        return os.path.join(args.dest, os.path.basename(device))
+
+    with ThreadPoolExecutor(max_workers=len(devices)) as pool:
+        futures = [pool.submit(transfer, device, args, dest_for(device)) for device in devices]
+        for future in futures:
+            for line in future.result():
+                print(line)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -34,16 +34,7 @@
 static int world_clock_instances;
 
 static void persist_world_clock_settings(world_clock_state_t *state) {
-    world_clock_settings_t maybe_settings;
-    char filename[13];
-
-    maybe_settings.reg = 0xFFFFFFFF;
-    sprintf(filename, "wclk_%03d.u32", state->clock_index);
-
-    filesystem_read_file(filename, (char *) &maybe_settings.reg, sizeof(world_clock_settings_t));
-    if (state->settings.reg != maybe_settings.reg) {
-        filesystem_write_file(filename, (char *) &state->settings.reg, sizeof(world_clock_settings_t));
-    }
+    movement_kv_put(MOVEMENT_KV_WORLD_CLOCK_BASE + state->clock_index, state->settings.reg);
 }
 
 static void advance_character_at_position(char *character, uint8_t position) {
@@ -121,7 +112,7 @@ static void advance_character_at_position(char *character, uint8_t position) {
 }
 
 static void _update_timezone_offset(world_clock_state_t *state) {
-    state->current_offset = movement_get_current_timezone_offset_for_zone(state->settings.bit.timezone_index);
+    state->current_offset = movement_get_timezone_offset_for_zone_at(state->settings.bit.timezone_index, movement_get_utc_timestamp());
 }
 
 void world_clock_face_setup(uint8_t watch_face_index, void ** context_ptr) {
@@ -132,12 +123,11 @@ void world_clock_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         world_clock_state_t *state = (world_clock_state_t *)*context_ptr;
         state->clock_index = world_clock_instances++;
 
-        // load settings from file if it exists
+        // load settings if we have them; they used to be stored in a file of their own.
         char filename[13];
         sprintf(filename, "wclk_%03d.u32", state->clock_index);
-        if (filesystem_file_exists(filename)) {
-            filesystem_read_file(filename, (char *) &state->settings.reg, sizeof(world_clock_settings_t));
-        } else {
+        filesystem_kv_import_file(MOVEMENT_KV_WORLD_CLOCK_BASE + state->clock_index, filename);
+        if (!movement_kv_get(MOVEMENT_KV_WORLD_CLOCK_BASE + state->clock_index, &state->settings.reg)) {
             // otherwise make all characters blank by default, and set to UTC time
             state->settings.bit.char_0 = ' ';
             state->settings.bit.char_1 = ' ';
@@ -163,6 +153,7 @@ static bool world_clock_face_do_display_mode(movement_event_t event, world_clock
     char buf[11];
 
     uint32_t previous_date_time;
+    uint32_t timestamp;
     watch_date_time_t date_time;
     switch (event.event_type) {
         case EVENT_ACTIVATE:
@@ -172,7 +163,10 @@ static bool world_clock_face_do_display_mode(movement_event_t event, world_clock
             // fall through
         case EVENT_TICK:
         case EVENT_LOW_ENERGY_UPDATE:
-            date_time = movement_get_date_time_in_zone(state->settings.bit.timezone_index);
+            // resolve the zone at this very second, so a DST change shows up on the tick it happens.
+            timestamp = movement_get_utc_timestamp();
+            state->current_offset = movement_get_timezone_offset_for_zone_at(state->settings.bit.timezone_index, timestamp);
+            date_time = watch_utility_date_time_from_unix_time(timestamp, state->current_offset);
             previous_date_time = state->previous_date_time;
             state->previous_date_time = date_time.reg;
             if ((date_time.reg >> 6) == (previous_date_time >> 6) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
@@ -185,9 +179,6 @@ static bool world_clock_face_do_display_mode(movement_event_t event, world_clock
                 sprintf(buf, "%02d%02d", date_time.unit.minute, date_time.unit.second);
                 watch_display_text(WATCH_POSITION_MINUTES, buf);
                 watch_display_text(WATCH_POSITION_SECONDS, buf + 2);
-                if (date_time.unit.minute % 15 == 0) {
-                    _update_timezone_offset(state);
-                }
             } else {
                 // other stuff changed; let's do it all.
                 if (!movement_clock_mode_24h()) {
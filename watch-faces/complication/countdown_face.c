@@ -35,17 +35,52 @@
 #define TAP_DETECTION_SECONDS 5
 
 static bool quick_ticks_running;
+static bool blink_hidden;
+// the settings blink and the quick ticks run on their own timers, so the face can stay at 1 Hz.
+static movement_timer_t blink_timer;
+static movement_timer_t quick_ticks_timer;
 
-static void abort_quick_ticks(countdown_state_t *state) {
+static void draw(countdown_state_t *state);
+static void settings_increment(countdown_state_t *state);
+
+static void blink_timer_fired(void *context) {
+    blink_hidden = !blink_hidden;
+    draw((countdown_state_t *)context);
+}
+
+static void start_blinking(countdown_state_t *state) {
+    // on for a quarter of a second, off for a quarter.
+    uint32_t quarter_second = watch_rtc_get_frequency() / 4;
+    blink_hidden = false;
+    movement_timer_start(&blink_timer, quarter_second, quarter_second, blink_timer_fired, state);
+}
+
+static void stop_blinking(void) {
+    movement_timer_stop(&blink_timer);
+    blink_hidden = false;
+}
+
+static void abort_quick_ticks(void) {
     if (quick_ticks_running) {
         quick_ticks_running = false;
-        if (state->mode == cd_setting)
-            movement_request_tick_frequency(4);
-        else
-            movement_request_tick_frequency(1);
+        movement_timer_stop(&quick_ticks_timer);
     }
 }
 
+static void quick_ticks_timer_fired(void *context) {
+    countdown_state_t *state = (countdown_state_t *)context;
+    if (HAL_GPIO_BTN_ALARM_read())
+        settings_increment(state);
+    else
+        abort_quick_ticks();
+    draw(state);
+}
+
+static void start_quick_ticks(countdown_state_t *state) {
+    uint32_t eighth_second = watch_rtc_get_frequency() / 8;
+    quick_ticks_running = movement_timer_start(&quick_ticks_timer, eighth_second, eighth_second, quick_ticks_timer_fired, state);
+}
+
 static void abort_tap_detection(countdown_state_t *state) {
     state->tap_detection_ticks = 0;
     movement_disable_tap_detection_if_available();
@@ -94,7 +129,7 @@ static void start(countdown_state_t *state) {
 
 
 
-static void draw(countdown_state_t *state, uint8_t subsecond) {
+static void draw(countdown_state_t *state) {
     char buf[16];
 
     uint32_t delta;
@@ -120,7 +155,7 @@ static void draw(countdown_state_t *state, uint8_t subsecond) {
             break;
         case cd_setting:
             sprintf(buf, "%2d%02d%02d", state->hours, state->minutes, state->seconds);
-            if (!quick_ticks_running && subsecond % 2) {
+            if (!quick_ticks_running && blink_hidden) {
                 switch(state->selection) {
                     case 0:
                         buf[0] = buf[1] = ' ';
@@ -231,16 +266,9 @@ bool countdown_face_loop(movement_event_t event, void *context) {
         case EVENT_ACTIVATE:
             if (watch_sleep_animation_is_running()) watch_stop_sleep_animation();
             watch_display_text_with_fallback(WATCH_POSITION_TOP, "TIMER", "CD");
-            draw(state, event.subsecond);
+            draw(state);
             break;
         case EVENT_TICK:
-            if (quick_ticks_running) {
-                if (HAL_GPIO_BTN_ALARM_read())
-                    settings_increment(state);
-                else
-                    abort_quick_ticks(state);
-            }
-
             if (state->mode == cd_running) {
                 state->now_ts++;
             }
@@ -250,10 +278,10 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                 if (state->tap_detection_ticks == 0) movement_disable_tap_detection_if_available();
             }
 
-            draw(state, event.subsecond);
+            draw(state);
             break;
         case EVENT_MODE_BUTTON_UP:
-            abort_quick_ticks(state);
+            abort_quick_ticks();
             movement_move_to_next_face();
             break;
         case EVENT_LIGHT_BUTTON_UP:
@@ -272,12 +300,12 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                         state->selection = 0;
                         state->mode = cd_reset;
                         store_countdown(state);
-                        movement_request_tick_frequency(1);
+                        stop_blinking();
                         button_beep();
                     }
                     break;
             }
-            draw(state, event.subsecond);
+            draw(state);
             break;
         case EVENT_ALARM_BUTTON_UP:
             switch(state->mode) {
@@ -299,7 +327,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                     settings_increment(state);
                     break;
             }
-            draw(state, event.subsecond);
+            draw(state);
             break;
         case EVENT_ALARM_LONG_PRESS:
             switch(state->mode) {
@@ -307,13 +335,12 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                     // long press in reset mode enters settings
                     abort_tap_detection(state);
                     state->mode = cd_setting;
-                    movement_request_tick_frequency(4);
+                    start_blinking(state);
                     button_beep();
                     break;
                 case cd_setting:
                     // long press in settings mode starts quick ticks for adjusting the time
-                    quick_ticks_running = true;
-                    movement_request_tick_frequency(8);
+                    start_quick_ticks(state);
                     break;
                 case cd_running:
                 case cd_paused:
@@ -345,7 +372,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
             }
             break;
         case EVENT_ALARM_LONG_UP:
-            abort_quick_ticks(state);
+            abort_quick_ticks();
             break;
         case EVENT_BACKGROUND_TASK:
             times_up(state);
@@ -355,7 +382,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
                 state->selection = 0;
                 state->mode = cd_reset;
                 store_countdown(state);
-                movement_request_tick_frequency(1);
+                stop_blinking();
             }
             if (state->mode != cd_running) {
                 movement_move_to_face(0);
@@ -385,7 +412,7 @@ bool countdown_face_loop(movement_event_t event, void *context) {
             }
             // reset the tap detection timer
             state->tap_detection_ticks = TAP_DETECTION_SECONDS;
-            draw(state, event.subsecond);
+            draw(state);
             break;
         default:
             movement_default_loop_handler(event);
@@ -402,6 +429,8 @@ void countdown_face_resign(void *context) {
         state->mode = cd_reset;
         store_countdown(state);
     }
+    abort_quick_ticks();
+    stop_blinking();
 
     // return accelerometer to the state it was in before
     abort_tap_detection(state);
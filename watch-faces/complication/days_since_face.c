@@ -32,21 +32,12 @@
 static int days_since_instances;
 
 static void persist_date(days_since_state_t *state) {
-    days_since_date_t maybe_date;
     days_since_date_t current_date = {0};
     current_date.bit.year = state->working_year;
     current_date.bit.month = state->working_month;
     current_date.bit.day = state->working_day;
 
-    char filename[13];
-
-    maybe_date.reg = 0xFFFFFFFF;
-    sprintf(filename, "since%03d.u32", state->face_index);
-
-    filesystem_read_file(filename, (char *) &maybe_date.reg, sizeof(days_since_date_t));
-    if (current_date.reg != maybe_date.reg) {
-        filesystem_write_file(filename, (char *) &current_date.reg, sizeof(days_since_date_t));
-    }
+    movement_kv_put(MOVEMENT_KV_DAYS_SINCE_BASE + state->face_index, current_date.reg);
 }
 
 static uint32_t _days_since_face_juliandaynum(uint16_t year, uint16_t month, uint16_t day) {
@@ -103,12 +94,11 @@ void days_since_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         days_since_state_t *state = (days_since_state_t *)*context_ptr;
         state->face_index = days_since_instances++;
 
-        // load date from file if it exists
+        // load the date if we have one; it used to be stored in a file of its own.
         char filename[13];
         sprintf(filename, "since%03d.u32", state->face_index);
-        if (filesystem_file_exists(filename)) {
-            filesystem_read_file(filename, (char *) &since_date, sizeof(days_since_date_t));
-        } else {
+        filesystem_kv_import_file(MOVEMENT_KV_DAYS_SINCE_BASE + state->face_index, filename);
+        if (!movement_kv_get(MOVEMENT_KV_DAYS_SINCE_BASE + state->face_index, &since_date.reg)) {
             // if birth date is not set, set a reasonable starting date. this works well for anyone under 65, but
             // you can keep pressing to go back to 1900; just go past the year 2080.
             since_date.bit.year = 1959;
@@ -42,18 +42,15 @@
 static const uint8_t _location_count = sizeof(longLatPresets) / sizeof(long_lat_presets_t);
 
 static void persist_location_to_filesystem(movement_location_t new_location) {
-    movement_location_t maybe_location = {0};
-
-    filesystem_read_file("location.u32", (char *) &maybe_location.reg, sizeof(movement_location_t));
-    if (new_location.reg != maybe_location.reg) {
-        filesystem_write_file("location.u32", (char *) &new_location.reg, sizeof(movement_location_t));
-    }
+    movement_kv_put(MOVEMENT_KV_LOCATION, new_location.reg);
 }
 
 static movement_location_t load_location_from_filesystem() {
     movement_location_t location = {0};
 
-    filesystem_read_file("location.u32", (char *) &location.reg, sizeof(movement_location_t));
+    // the location used to be stored in a file of its own.
+    filesystem_kv_import_file(MOVEMENT_KV_LOCATION, "location.u32");
+    movement_kv_get(MOVEMENT_KV_LOCATION, &location.reg);
 
     return location;
 }
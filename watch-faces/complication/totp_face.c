@@ -71,6 +71,14 @@ static totp_t credentials[] = {
 // END OF KEY DATA.
 ////////////////////////////////////////////////////////////////////////////////
 
+#define TOTP_FACE_CREDENTIALS (sizeof(credentials) / sizeof(*credentials))
+
+/* Each key's HMAC midstates, so the keys only need decoding once, and
+ * its current and next codes, so scrolling is just a lookup.
+ */
+static totp_hmac_state totp_hmac_states[TOTP_FACE_CREDENTIALS];
+static totp_cached_code totp_codes[TOTP_FACE_CREDENTIALS];
+
 static inline totp_t *totp_at(size_t i) {
     return &credentials[i];
 }
@@ -80,43 +88,40 @@ static inline totp_t *totp_current(totp_state_t *totp_state) {
 }
 
 static inline size_t totp_total(void) {
-    return sizeof(credentials) / sizeof(*credentials);
+    return TOTP_FACE_CREDENTIALS;
 }
 
-static void totp_validate_key_lengths(void) {
+static void totp_prepare_keys(void) {
+    uint8_t decoded_key[TOTP_FACE_MAX_KEY_LENGTH];
+
     for (size_t n = totp_total(), i = 0; i < n; ++i) {
         totp_t *totp = totp_at(i);
+        size_t decoded_key_length = 0;
 
-        if (UNBASE32_LEN(totp->encoded_key_length) > TOTP_FACE_MAX_KEY_LENGTH) {
-            // Key exceeds static limits, turn it off by zeroing the length
-            totp->encoded_key_length = 0;
+        if (UNBASE32_LEN(totp->encoded_key_length) <= TOTP_FACE_MAX_KEY_LENGTH) {
+            decoded_key_length = base32_decode(totp->encoded_key, decoded_key);
         }
-    }
-}
 
-static void totp_generate(totp_state_t *totp_state) {
-    totp_t *totp = totp_current(totp_state);
+        if (decoded_key_length == 0) {
+            // Key exceeds static limits or isn't base 32, turn it off by zeroing the length
+            totp->encoded_key_length = 0;
+            continue;
+        }
 
-    if (totp->encoded_key_length <= 0) {
-        // Key exceeded static limits and was turned off
-        totp_state->current_decoded_key_length = 0;
-        return;
+        TOTPInitState(&totp_hmac_states[i], decoded_key, decoded_key_length, totp->period, totp->algorithm);
+        memset(&totp_codes[i], 0, sizeof(totp_codes[i]));
     }
 
-    totp_state->current_decoded_key_length = base32_decode(totp->encoded_key, totp_state->current_decoded_key);
+    memset(decoded_key, 0, sizeof(decoded_key));
+}
 
-    if (totp_state->current_decoded_key_length == 0) {
-        // Decoding failed for some reason
-        // Not a base 32 string?
-        return;
+static void totp_update_codes(totp_state_t *totp_state) {
+    // all of the codes at once: at a step boundary this is one burst of hashing, and otherwise it does nothing.
+    for (size_t n = totp_total(), i = 0; i < n; ++i) {
+        if (totp_at(i)->encoded_key_length > 0) {
+            updateCachedCode(&totp_hmac_states[i], &totp_codes[i], totp_state->timestamp);
+        }
     }
-
-    TOTP(
-        totp_state->current_decoded_key,
-        totp_state->current_decoded_key_length,
-        totp->period,
-        totp->algorithm
-    );
 }
 
 static void totp_display_error(totp_state_t *totp_state) {
@@ -129,34 +134,23 @@ static void totp_display_error(totp_state_t *totp_state) {
 
 static void totp_display_code(totp_state_t *totp_state) {
     char buf[14];
-    div_t result;
     uint8_t valid_for;
     totp_t *totp = totp_current(totp_state);
 
-    result = div(totp_state->timestamp, totp->period);
-    if (result.quot != totp_state->steps) {
-        totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-        totp_state->steps = result.quot;
-    }
-    valid_for = totp->period - result.rem;
-    sprintf(buf, "%c%c%2d%06lu", totp->labels[0], totp->labels[1], valid_for, totp_state->current_code);
+    valid_for = totp->period - totp_state->timestamp % totp->period;
+    sprintf(buf, "%c%c%2d%06lu", totp->labels[0], totp->labels[1], valid_for, totp_codes[totp_state->current_index].code);
 
     watch_display_text(0, buf);
 }
 
 static void totp_display(totp_state_t *totp_state) {
-    if (totp_state->current_decoded_key_length > 0) {
+    if (totp_current(totp_state)->encoded_key_length > 0) {
         totp_display_code(totp_state);
     } else {
         totp_display_error(totp_state);
     }
 }
 
-static void totp_generate_and_display(totp_state_t *totp_state) {
-    totp_generate(totp_state);
-    totp_display(totp_state);
-}
-
 static inline uint32_t totp_compute_base_timestamp() {
     return movement_get_utc_timestamp();
 }
@@ -164,11 +158,9 @@ static inline uint32_t totp_compute_base_timestamp() {
 void totp_face_setup(uint8_t watch_face_index, void ** context_ptr) {
     (void) watch_face_index;
 
-    totp_validate_key_lengths();
-
     if (*context_ptr == NULL) {
+        totp_prepare_keys();
         totp_state_t *totp = malloc(sizeof(totp_state_t));
-        totp->current_decoded_key = malloc(TOTP_FACE_MAX_KEY_LENGTH);
         *context_ptr = totp;
     }
 }
@@ -178,13 +170,10 @@ void totp_face_activate(void *context) {
     totp_state_t *totp = (totp_state_t *) context;
 
     totp->timestamp = totp_compute_base_timestamp();
-    totp->steps = 0;
-    totp->current_code = 0;
     totp->current_index = 0;
-    totp->current_decoded_key_length = 0;
-    // totp->current_decoded_key is already initialized in setup
 
-    totp_generate_and_display(totp);
+    totp_update_codes(totp);
+    totp_display(totp);
 }
 
 bool totp_face_loop(movement_event_t event, void *context) {
@@ -194,6 +183,7 @@ bool totp_face_loop(movement_event_t event, void *context) {
     switch (event.event_type) {
         case EVENT_TICK:
             totp_state->timestamp++;
+            totp_update_codes(totp_state);
             // fall through
         case EVENT_ACTIVATE:
             totp_display(totp_state);
@@ -209,7 +199,7 @@ bool totp_face_loop(movement_event_t event, void *context) {
                 totp_state->current_index = 0;
             }
 
-            totp_generate_and_display(totp_state);
+            totp_display(totp_state);
 
             break;
         case EVENT_LIGHT_BUTTON_UP:
@@ -220,7 +210,7 @@ bool totp_face_loop(movement_event_t event, void *context) {
                 totp_state->current_index--;
             }
 
-            totp_generate_and_display(totp_state);
+            totp_display(totp_state);
 
             break;
         case EVENT_ALARM_BUTTON_DOWN:
@@ -68,14 +68,11 @@
  */
 
 #include "movement.h"
+#include "TOTP.h"
 
 typedef struct {
     uint32_t timestamp;
-    uint8_t steps;
-    uint32_t current_code;
     uint8_t current_index;
-    uint8_t *current_decoded_key;
-    size_t current_decoded_key_length;
 } totp_state_t;
 
 void totp_face_setup(uint8_t watch_face_index, void ** context_ptr);
@@ -27,166 +27,64 @@
 #include <math.h>
 
 #include "TOTP.h"
-#include "base32.h"
 
 #include "watch.h"
-#include "filesystem.h"
+#include "totp_db.h"
 
 #include "totp_lfs_face.h"
 
-#define MAX_TOTP_RECORDS 30
-#define MAX_TOTP_SECRET_SIZE 128
-#define TOTP_FILE "totp_uris.txt"
+// Read into here from the database, then precomputed into the record's HMAC state and wiped.
+static uint8_t current_secret[TOTP_DB_MAX_SECRET_SIZE];
 
-const char* TOTP_URI_START = "otpauth://totp/";
-
-struct totp_record {
-    char label[4];
-    hmac_alg algorithm;
-    uint8_t period;
-    uint8_t secret_size;
-
-    union {
-        uint8_t *secret;
-        struct {
-            uint16_t file_secret_offset;
-            uint16_t file_secret_length;
-        };
-    };
-};
-
-/* This is used if we're not storing all the secrets but instead
- * calculating them on demand. Avoids malloc in normal operation.
+static struct totp_record totp_records[TOTP_DB_MAX_RECORDS];
+/* One per record, allocated as they're read, so that a new code
+ * is just two hash compressions; the secrets aren't kept at all.
  */
-static uint8_t current_secret[MAX_TOTP_SECRET_SIZE];
-
-static struct totp_record totp_records[MAX_TOTP_RECORDS];
+static totp_hmac_state *totp_hmac_states = NULL;
+/* Also one per record: the current and next codes, all brought up
+ * to date together each second, so scrolling is just a lookup.
+ */
+static totp_cached_code *totp_codes = NULL;
 static uint8_t num_totp_records = 0;
+// The import these records came from, so that one from the shell shows up straight away.
+static uint16_t totp_db_generation = 0;
 
-static void init_totp_record(struct totp_record *totp_record) {
-    totp_record->label[0] = 'A';
-    totp_record->label[1] = 'A';
-    totp_record->label[2] = 'A';
-    totp_record->label[3] = 0;
-    totp_record->algorithm = SHA1;
-    totp_record->period = 30;
-    totp_record->secret_size = 0;
-}
+static void totp_lfs_face_read_db(void) {
+    num_totp_records = 0;
+    totp_db_generation = totp_db_get_generation();
 
-static bool totp_lfs_face_read_param(struct totp_record *totp_record, char *param, char *value) {
-    if (!strcmp(param, "issuer")) {
-        if (value[0] == '\0') {
-            printf("TOTP issuer must be a non-empty string\n");
-            return false;
-        }
-        snprintf(totp_record->label, sizeof(totp_record->label), "%-3s", value);
-    } else if (!strcmp(param, "secret")) {
-        totp_record->file_secret_length = strlen(value);
-        if (UNBASE32_LEN(totp_record->file_secret_length) > MAX_TOTP_SECRET_SIZE) {
-            printf("TOTP secret too long: %s\n", value);
-            return false;
-        }
-        totp_record->secret_size = base32_decode((unsigned char *)value, current_secret);
-        if (totp_record->secret_size == 0) {
-            printf("TOTP can't decode secret: %s\n", value);
-            return false;
-        }
-    } else if (!strcmp(param, "digits")) {
-        if (!strcmp(param, "6")) {
-            printf("TOTP got %s, not 6 digits\n", value);
-            return false;
-        }
-    } else if (!strcmp(param, "period")) {
-        totp_record->period = atoi(value);
-        if (totp_record->period == 0) {
-            printf("TOTP invalid period %s\n", value);
-            return false;
-        }
-    } else if (!strcmp(param, "algorithm")) {
-        if (!strcmp(value, "SHA1")) {
-            totp_record->algorithm = SHA1;
-        }
-        else if (!strcmp(value, "SHA224")) {
-            totp_record->algorithm = SHA224;
-        }
-        else if (!strcmp(value, "SHA256")) {
-            totp_record->algorithm = SHA256;
-        }
-        else if (!strcmp(value, "SHA384")) {
-            totp_record->algorithm = SHA384;
-        }
-        else if (!strcmp(value, "SHA512")) {
-            totp_record->algorithm = SHA512;
-        }
-        else {
-            printf("TOTP ignored due to algorithm %s\n", value);
-            return false;
-        }
-    }
-
-    return true;
-}
-
-static void totp_lfs_face_read_file(char *filename) {
-    // For 'format' of file, see comment at top.
-    const size_t uri_start_len = strlen(TOTP_URI_START);
-
-    if (!filesystem_file_exists(filename)) {
-        printf("TOTP file error: %s\n", filename);
+    filesystem_handle_t db = totp_db_open();
+    if (db < 0) {
         return;
     }
 
-    char line[256];
-    int32_t offset = 0, old_offset = 0;
-    while (old_offset = offset, filesystem_read_line(filename, line, &offset, 255) && strlen(line)) {
-        if (num_totp_records == MAX_TOTP_RECORDS) {
-            printf("TOTP max records: %d\n", MAX_TOTP_RECORDS);
+    while (num_totp_records < TOTP_DB_MAX_RECORDS &&
+           totp_db_read_record(db, &totp_records[num_totp_records], current_secret)) {
+        struct totp_record *record = &totp_records[num_totp_records];
+        totp_hmac_state *states = realloc(totp_hmac_states, (num_totp_records + 1) * sizeof(totp_hmac_state));
+        if (states == NULL) {
+            printf("TOTP out of memory\n");
             break;
         }
-
-        // Check that it looks like a URI
-        if (strncmp(TOTP_URI_START, line, uri_start_len)) {
-            printf("TOTP invalid uri start: %s\n", line);
-            continue;
-        }
-
-        // Check that we can find a '?' (to start our parameters)
-        char *param;
-        char *param_saveptr = NULL;
-        char *params = strchr(line + uri_start_len, '?');
-        if (params == NULL) {
-            printf("TOTP no params: %s\n", line);
-            continue;
+        totp_hmac_states = states;
+        totp_cached_code *codes = realloc(totp_codes, (num_totp_records + 1) * sizeof(totp_cached_code));
+        if (codes == NULL) {
+            printf("TOTP out of memory\n");
+            break;
         }
+        totp_codes = codes;
+        memset(&totp_codes[num_totp_records], 0, sizeof(totp_cached_code));
+        TOTPInitState(&totp_hmac_states[num_totp_records], current_secret, record->secret_size, record->period, record->algorithm);
+        num_totp_records += 1;
+    }
 
-        // Process the parameters and put them in the record
-        init_totp_record(&totp_records[num_totp_records]);
-        bool error = false;
-        param = strtok_r(params + 1, "&", &param_saveptr);
-        do {
-            char *param_middle = strchr(param, '=');
-            *param_middle = '\0';
-            if (totp_lfs_face_read_param(&totp_records[num_totp_records], param, param_middle + 1)) {
-                if (!strcmp(param, "secret")) {
-                    totp_records[num_totp_records].file_secret_offset = old_offset + (param_middle + 1 - line);
-                }
-            } else {
-                error = true;
-            }
-        } while ((param = strtok_r(NULL, "&", &param_saveptr)));
-
-        if (error) {
-            totp_records[num_totp_records].secret_size = 0;
-            continue;
-        }
+    memset(current_secret, 0, sizeof(current_secret));
+    filesystem_close(db);
+}
 
-        // If we found a probably valid TOTP record, keep it.
-        if (totp_records[num_totp_records].secret_size) {
-            num_totp_records += 1;
-        } else {
-            printf("TOTP missing secret: %s\n", line);
-        }
-    }
+static void totp_lfs_face_load(void) {
+    totp_db_refresh();
+    totp_lfs_face_read_db();
 }
 
 void totp_lfs_face_setup(uint8_t watch_face_index, void ** context_ptr) {
@@ -197,47 +95,38 @@ void totp_lfs_face_setup(uint8_t watch_face_index, void ** context_ptr) {
 
 #if !(__EMSCRIPTEN__)
     if (num_totp_records == 0) {
-        totp_lfs_face_read_file(TOTP_FILE);
+        totp_lfs_face_load();
     }
 #endif
 }
 
-static uint8_t *totp_lfs_face_get_file_secret(struct totp_record *record) {
-    char buffer[BASE32_LEN(MAX_TOTP_SECRET_SIZE) + 1];
-    int32_t file_secret_offset = record->file_secret_offset;
-
-    /* TODO filesystem_read_line is quite inefficient. Consider writing a new function,
-     * and keeping the file open?
-     */
-    if (!filesystem_read_line(TOTP_FILE, buffer, &file_secret_offset, record->file_secret_length + 1)) {
-        /* Shouldn't happen at this point. Return current_secret, which is misleading but will not cause a crash. */
-        printf("TOTP can't read expected secret from totp_uris.txt (failed readline)\n");
-        return current_secret;
-    }
-    if (base32_decode((unsigned char *)buffer, current_secret) != record->secret_size) {
-        printf("TOTP can't properly decode secret '%s' from totp_uris.txt; failed at offset %d; read to %ld\n", buffer, record->file_secret_offset, file_secret_offset);
-    }
-    return current_secret;
-}
-
 static void totp_face_set_record(totp_lfs_state_t *totp_state, int i) {
-    struct totp_record *record;
-
     if (num_totp_records == 0 && i >= num_totp_records) {
         return;
     }
 
     totp_state->current_index = i;
-    record = &totp_records[i];
+}
+
+static void totp_face_update_codes(totp_lfs_state_t *totp_state) {
+    // all of the codes at once: at a step boundary this is one burst of hashing, and otherwise it does nothing.
+    for (uint8_t i = 0; i < num_totp_records; i++) {
+        updateCachedCode(&totp_hmac_states[i], &totp_codes[i], totp_state->timestamp);
+    }
+}
 
-    TOTP(
-        totp_lfs_face_get_file_secret(record),
-        record->secret_size,
-        record->period,
-        record->algorithm
-    );
-    totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-    totp_state->steps = totp_state->timestamp / record->period;
+/* Picks up an import since the records were read, from the shell or
+ * from totp_db_refresh. The index may be past the new end of the table,
+ * and the codes are for the old secrets.
+ */
+static void totp_face_check_db(totp_lfs_state_t *totp_state) {
+    if (totp_db_generation == totp_db_get_generation()) {
+        return;
+    }
+
+    totp_lfs_face_read_db();
+    totp_face_set_record(totp_state, 0);
+    totp_face_update_codes(totp_state);
 }
 
 void totp_lfs_face_activate(void *context) {
@@ -248,11 +137,15 @@ void totp_lfs_face_activate(void *context) {
     if (num_totp_records == 0) {
         // Doing this here rather than in setup makes things a bit more pleasant in the simulator, since there's no easy way to trigger
         // setup again after uploading the data.
-        totp_lfs_face_read_file(TOTP_FILE);
+        totp_lfs_face_load();
     }
 #endif
+    // pick up a totp_uris.txt that has changed since, say one just copied over with put.
+    totp_db_refresh();
 
     totp_state->timestamp = movement_get_utc_timestamp();
+    totp_face_check_db(totp_state);
+    totp_face_update_codes(totp_state);
     totp_face_set_record(totp_state, 0);
 }
 
@@ -265,17 +158,12 @@ static void totp_face_display(totp_lfs_state_t *totp_state) {
         return;
     }
 
-    div_t result = div(totp_state->timestamp, totp_records[index].period);
-    if (result.quot != totp_state->steps) {
-        totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-        totp_state->steps = result.quot;
-    }
-    uint8_t valid_for = totp_records[index].period - result.rem;
+    uint8_t valid_for = totp_records[index].period - totp_state->timestamp % totp_records[index].period;
 
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, totp_records[index].label, totp_records[index].label);
     sprintf(buf, "%2d", valid_for);
     watch_display_text_with_fallback(WATCH_POSITION_TOP_RIGHT, buf, buf);
-    sprintf(buf, "%06lu", totp_state->current_code);
+    sprintf(buf, "%06lu", totp_codes[index].code);
     watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, buf, buf);
 }
 
@@ -286,6 +174,8 @@ bool totp_lfs_face_loop(movement_event_t event, void *context) {
     switch (event.event_type) {
         case EVENT_TICK:
             totp_state->timestamp++;
+            totp_face_check_db(totp_state);
+            totp_face_update_codes(totp_state);
             totp_face_display(totp_state);
             break;
         case EVENT_ACTIVATE:
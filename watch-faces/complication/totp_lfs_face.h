@@ -43,6 +43,18 @@
  *   echo otpauth://totp/ACME%20Co:john.doe@email.com?secret=HXDMVJECJJWSRB3HWIZR4IFUGFTMXBOZ&issuer=ACME%20Co&algorithm=SHA1&digits=6&period=30 >> totp_uris.txt
  * (note the double >> in the second one)
  *
+ * The face doesn't read the URIs every time; it keeps the parsed records,
+ * with their secrets already decoded, in a binary file "totp.db" (see
+ * lib/totp_db). That
+ * file is made from totp_uris.txt when the face starts or comes on screen
+ * and totp_uris.txt has changed since the last time. To rebuild it right
+ * away, or from a different file, run this in the serial console:
+ *   totp_import
+ *   totp_import other_file.txt
+ * The import replaces the database, so the file needs to list every record.
+ * If it fails, the old database is kept. Once imported you may delete
+ * totp_uris.txt, though you'll need it again to make changes.
+ *
  * You may want to customise the characters that appear to identify the 2FA
  * code. These are just the first two characters of the issuer, and it's fine
  * to modify the URI.
@@ -56,8 +68,6 @@
 
 typedef struct {
     uint32_t timestamp;
-    uint8_t steps;
-    uint32_t current_code;
     uint8_t current_index;
 } totp_lfs_state_t;
 
@@ -82,7 +82,8 @@ bool accelerometer_status_face_loop(movement_event_t event, void *context) {
                     } else {
                         watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
                         watch_display_text_with_fallback(WATCH_POSITION_TOP, "WAKth", "TH");
-                        watch_display_float_with_best_effort(state->new_threshold * 0.03125, " G");
+                        // the threshold is in 1/32 g; show it in hundredths, rounded.
+                        watch_display_fixed_with_best_effort((state->new_threshold * 100 + 16) / 32, " G");
                         printf("%s\n", buf);
                     }
                 }
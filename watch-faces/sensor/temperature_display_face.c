@@ -30,11 +30,12 @@
 static bool skip = false;
 
 static void _temperature_display_face_update_display(bool in_fahrenheit) {
-    float temperature_c = movement_get_temperature();
+    int32_t temperature_centi = movement_get_temperature_centi();
     if (in_fahrenheit) {
-        watch_display_float_with_best_effort(temperature_c * 1.8 + 32.0, "#F");
+        // hundredths of a degree C to hundredths of a degree F, rounded.
+        watch_display_fixed_with_best_effort((temperature_centi * 9 + (temperature_centi < 0 ? -2 : 2)) / 5 + 3200, "#F");
     } else {
-        watch_display_float_with_best_effort(temperature_c, "#C");
+        watch_display_fixed_with_best_effort(temperature_centi, "#C");
     }
 }
 
@@ -42,7 +43,7 @@ void temperature_display_face_setup(uint8_t watch_face_index, void ** context_pt
     (void) watch_face_index;
     (void) context_ptr;
     // if temperature is invalid, we don't have a temperature sensor which means we shouldn't be here.
-    if (movement_get_temperature() == 0xFFFFFFFF) skip = true;
+    if (movement_get_temperature_centi() == MOVEMENT_TEMPERATURE_UNAVAILABLE) skip = true;
 }
 
 void temperature_display_face_activate(void *context) {
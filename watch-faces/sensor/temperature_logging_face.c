@@ -34,10 +34,16 @@ static void _temperature_logging_face_log_data(temperature_logging_state_t *logg
     size_t pos = logger_state->data_points % TEMPERATURE_LOGGING_NUM_DATA_POINTS;
 
     logger_state->data[pos].timestamp.reg = date_time.reg;
-    logger_state->data[pos].temperature_c = movement_get_temperature();
+    logger_state->data[pos].temperature_centi = movement_get_temperature_centi();
     logger_state->data_points++;
 }
 
+static void _temperature_logging_face_schedule_next_log(temperature_logging_state_t *logger_state) {
+    // log at the top of each hour.
+    uint32_t now = movement_get_utc_timestamp();
+    movement_schedule_wakeup_for_face(logger_state->watch_face_index, now - now % 3600 + 3600);
+}
+
 static void _temperature_logging_face_update_display(temperature_logging_state_t *logger_state, bool in_fahrenheit, bool clock_mode_24h) {
     int8_t pos = (logger_state->data_points - 1 - logger_state->display_index) % TEMPERATURE_LOGGING_NUM_DATA_POINTS;
     char buf[7];
@@ -73,23 +79,26 @@ static void _temperature_logging_face_update_display(temperature_logging_state_t
         watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LOG", "TL");
         sprintf(buf, "%2d", logger_state->display_index);
         watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+        int32_t temperature_centi = logger_state->data[pos].temperature_centi;
         if (in_fahrenheit) {
-            watch_display_float_with_best_effort(logger_state->data[pos].temperature_c * 1.8 + 32.0, "#F");
+            // hundredths of a degree C to hundredths of a degree F, rounded.
+            watch_display_fixed_with_best_effort((temperature_centi * 9 + (temperature_centi < 0 ? -2 : 2)) / 5 + 3200, "#F");
         } else {
-            watch_display_float_with_best_effort(logger_state->data[pos].temperature_c, "#C");
+            watch_display_fixed_with_best_effort(temperature_centi, "#C");
         }
     }
 }
 
 void temperature_logging_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
-
     // if temperature is invalid, we don't have a temperature sensor which means we shouldn't be here.
-    if (movement_get_temperature() == 0xFFFFFFFF) skip = true;
+    if (movement_get_temperature_centi() == MOVEMENT_TEMPERATURE_UNAVAILABLE) skip = true;
 
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(temperature_logging_state_t));
         memset(*context_ptr, 0, sizeof(temperature_logging_state_t));
+        temperature_logging_state_t *logger_state = (temperature_logging_state_t *)*context_ptr;
+        logger_state->watch_face_index = watch_face_index;
+        if (!skip) _temperature_logging_face_schedule_next_log(logger_state);
     }
 }
 
@@ -131,6 +140,7 @@ bool temperature_logging_face_loop(movement_event_t event, void *context) {
             break;
         case EVENT_BACKGROUND_TASK:
             _temperature_logging_face_log_data(logger_state);
+            _temperature_logging_face_schedule_next_log(logger_state);
             break;
         default:
             movement_default_loop_handler(event);
@@ -143,14 +153,3 @@ bool temperature_logging_face_loop(movement_event_t event, void *context) {
 void temperature_logging_face_resign(void *context) {
     (void) context;
 }
-
-movement_watch_face_advisory_t temperature_logging_face_advise(void *context) {
-    (void) context;
-    movement_watch_face_advisory_t retval = { 0 };
-
-    // this will get called at the top of each minute, so all we check is if we're at the top of the hour as well.
-    // if we are, we ask for a background task.
-    retval.wants_background_task = watch_rtc_get_date_time().unit.minute == 0;
-
-    return retval;
-}
@@ -61,12 +61,13 @@
 
 typedef struct {
     watch_date_time_t timestamp;
-    float temperature_c;
+    int16_t temperature_centi; // hundredths of a degree celsius
 } thermistor_logger_data_point_t;
 
 typedef struct {
     uint8_t display_index;  // the index we are displaying on screen
     uint8_t ts_ticks;       // when the user taps the LIGHT button, we show the timestamp for a few ticks.
+    uint8_t watch_face_index; // for scheduling the next reading
     int32_t data_points;    // the absolute number of data points logged
     thermistor_logger_data_point_t data[TEMPERATURE_LOGGING_NUM_DATA_POINTS];
 } temperature_logging_state_t;
@@ -75,12 +76,11 @@ void temperature_logging_face_setup(uint8_t watch_face_index, void ** context_pt
 void temperature_logging_face_activate(void *context);
 bool temperature_logging_face_loop(movement_event_t event, void *context);
 void temperature_logging_face_resign(void *context);
-movement_watch_face_advisory_t temperature_logging_face_advise(void *context);
 
 #define temperature_logging_face ((const watch_face_t){ \
     temperature_logging_face_setup, \
     temperature_logging_face_activate, \
     temperature_logging_face_loop, \
     temperature_logging_face_resign, \
-    temperature_logging_face_advise, \
+    NULL, \
 })
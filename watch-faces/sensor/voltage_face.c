@@ -28,10 +28,11 @@
 #include "watch.h"
 
 static void _voltage_face_update_display(void) {
-    float voltage = (float)watch_get_vcc_voltage() / 1000.0;
+    // millivolts to hundredths of a volt, rounded.
+    int32_t voltage_times_100 = (watch_get_vcc_voltage() + 5) / 10;
 
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "BAT", "BA");
-    watch_display_float_with_best_effort(voltage, " V");
+    watch_display_fixed_with_best_effort(voltage_times_100, " V");
 }
 
 void voltage_face_setup(uint8_t watch_face_index, void ** context_ptr) {
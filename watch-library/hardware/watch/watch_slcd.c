@@ -249,7 +249,7 @@ void watch_enable_display(void) {
     // calculate the smallest duration we can time before we have to engage the frame counter prescaler bypass
     _slcd_fc_min_ms_bypass = 32 * (1000 / _slcd_framerate);
 
-    slcd_clear();
+    watch_clear_display();
 
     if (_installed_display == WATCH_LCD_TYPE_CUSTOM) {
         slcd_set_contrast(0);
@@ -264,16 +264,14 @@ void watch_disable_display(void) {
     slcd_disable();
 }
 
-inline void watch_set_pixel(uint8_t com, uint8_t seg) {
-    slcd_set_segment(com, seg);
-}
-
-inline void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    slcd_clear_segment(com, seg);
-}
+void _watch_display_write_com(uint8_t com, uint32_t segments) {
+    // TODO: wrap this in gossamer call
+    volatile uint32_t *sdatal[] = {
+        &SLCD->SDATAL0.reg, &SLCD->SDATAL1.reg, &SLCD->SDATAL2.reg, &SLCD->SDATAL3.reg, &SLCD->SDATAL4.reg
+    };
 
-void watch_clear_display(void) {
-    slcd_clear();
+    if (com >= sizeof(sdatal) / sizeof(sdatal[0])) return;
+    if (*sdatal[com] != segments) *sdatal[com] = segments;
 }
 
 void watch_start_character_blink(char character, uint32_t duration) {
@@ -2,6 +2,7 @@
 #include <string.h>
 #include <stdio.h>
 #include "watch_storage.h"
+#include "watch_deepsleep.h"
 
 #define RWWEE_ADDR_START NVMCTRL_RWW_EEPROM_ADDR
 #define RWWEE_ADDR_END (NVMCTRL_RWW_EEPROM_ADDR + NVMCTRL_PAGE_SIZE * NVMCTRL_RWWEE_PAGES)
@@ -47,7 +48,30 @@ bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t
     return true;
 }
 
-bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+static volatile bool _watch_storage_busy;
+static volatile bool _watch_storage_success = true;
+static watch_storage_cb_t _watch_storage_callback;
+
+void irq_handler_nvmctrl(void);
+
+static void _watch_storage_wait_for_page_buffer(void) {
+    // a page buffer clear only takes a few cycles, not worth sleeping for.
+    while (!NVMCTRL->INTFLAG.bit.READY);
+}
+
+static void _watch_storage_start(uint32_t command, uint32_t address, watch_storage_cb_t callback) {
+    _watch_storage_callback = callback;
+    _watch_storage_busy = true;
+
+    NVMCTRL->ADDR.reg = address / 2;
+    NVMCTRL->CTRLA.reg = command | NVMCTRL_CTRLA_CMDEX_KEY;
+
+    // READY drops as soon as the command is accepted; the interrupt fires when it comes back.
+    NVMCTRL->INTENSET.reg = NVMCTRL_INTENSET_READY;
+    NVIC_EnableIRQ(NVMCTRL_IRQn);
+}
+
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size, watch_storage_cb_t callback) {
     uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE + offset;
     if (!_is_valid_address(address, size)) return false;
 
@@ -57,7 +81,7 @@ bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, u
     uint16_t i, data;
 
     NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_PBC | NVMCTRL_CTRLA_CMDEX_KEY;
-    watch_storage_sync();
+    _watch_storage_wait_for_page_buffer();
 
     for (i = 0; i < size; i += 2) {
         data = buffer[i];
@@ -66,29 +90,69 @@ bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, u
         }
         NVM_MEMORY[nvm_address++] = data;
     }
-    NVMCTRL->ADDR.reg = address / 2;
-    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_RWWEEWP | NVMCTRL_CTRLA_CMDEX_KEY;
+    _watch_storage_start(NVMCTRL_CTRLA_CMD_RWWEEWP, address, callback);
 
     return true;
 }
 
-bool watch_storage_erase(uint32_t row) {
+bool watch_storage_erase_async(uint32_t row, watch_storage_cb_t callback) {
     uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE;
     if (!_is_valid_address(address, NVMCTRL_ROW_SIZE)) return false;
 
     watch_storage_sync();
-    NVMCTRL->ADDR.reg = address / 2;
-    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_RWWEEER | NVMCTRL_CTRLA_CMDEX_KEY;
+    _watch_storage_start(NVMCTRL_CTRLA_CMD_RWWEEER, address, callback);
 
     return true;
 }
 
+bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    return watch_storage_write_async(row, offset, buffer, size, NULL);
+}
+
+bool watch_storage_erase(uint32_t row) {
+    return watch_storage_erase_async(row, NULL);
+}
+
+bool watch_storage_is_busy(void) {
+    return _watch_storage_busy;
+}
+
 bool watch_storage_sync(void) {
-    while (!NVMCTRL->INTFLAG.bit.READY) {
-        // wait for flash to become ready
+    if (__get_IPSR() != 0) {
+        // we're in an interrupt handler, possibly one that outranks the flash controller's. wait it out here.
+        while (!NVMCTRL->INTFLAG.bit.READY);
+        if (_watch_storage_busy) {
+            irq_handler_nvmctrl();
+            // READY has already latched the interrupt; don't let it run the handler again once we return.
+            NVIC_ClearPendingIRQ(NVMCTRL_IRQn);
+        }
     }
 
+    while (_watch_storage_busy) {
+        // with interrupts masked, the READY interrupt can't slip in between the check and the WFI; it will still
+        // wake us, and run as soon as they're unmasked. IDLE rather than STANDBY keeps the controller's clock running.
+        __disable_irq();
+        if (_watch_storage_busy) sleep(PM_SLEEPCFG_SLEEPMODE_IDLE_Val);
+        __enable_irq();
+    }
+
+    return _watch_storage_success;
+}
+
+void irq_handler_nvmctrl(void) {
+    // a stale pending interrupt can land while a newer command is still running; that one will raise its own.
+    if (!NVMCTRL->INTFLAG.bit.READY) return;
+    NVMCTRL->INTENCLR.reg = NVMCTRL_INTENCLR_READY;
+    // ...or after watch_storage_sync already handled the command, when there's nothing left to report.
+    if (!_watch_storage_busy) return;
+
+    _watch_storage_success = !(NVMCTRL->STATUS.reg & (NVMCTRL_STATUS_PROGE | NVMCTRL_STATUS_LOCKE | NVMCTRL_STATUS_NVME));
     NVMCTRL->STATUS.reg = NVMCTRL_STATUS_MASK;
+    NVMCTRL->INTFLAG.reg = NVMCTRL_INTFLAG_ERROR;
 
-    return true;
+    watch_storage_cb_t callback = _watch_storage_callback;
+    _watch_storage_callback = NULL;
+    _watch_storage_busy = false;
+
+    if (callback != NULL) callback(_watch_storage_success);
 }
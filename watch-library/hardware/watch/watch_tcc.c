@@ -36,6 +36,11 @@ static void _watch_disable_led_pins(void);
 static void (*_cb_tc0)(void) = NULL;
 static void cb_watch_buzzer_seq(void);
 static void cb_watch_buzzer_raw_source(void);
+#ifdef WATCH_BUZZER_DMA
+static bool _watch_buzzer_timeline_start(int8_t *note_sequence);
+static void _watch_buzzer_timeline_stop(void);
+static void _watch_buzzer_timeline_set_led_duty_cycles(void);
+#endif
 
 static uint16_t _seq_position;
 static int8_t _tone_ticks, _repeat_counter;
@@ -52,6 +57,37 @@ static volatile uint8_t _current_led_color[3] = {0, 0, 0};
 
 static void _watch_set_led_duty_cycle(uint32_t period, uint8_t red, uint8_t green, uint8_t blue);
 
+#ifdef WATCH_BUZZER_DMA
+// With WATCH_BUZZER_DMA (make BUZZER_DMA=1), sequences that compile into a timeline play without the CPU: TC0
+// counts out each note's duration in 64 Hz ticks, and each time it overflows, it triggers one beat on each of these
+// DMA channels, which load the next note's period and duty cycle into the TCC's buffer registers, and its duration
+// into TC0's compare register. The LED channels get their compare values reloaded too, scaled to the new period, so
+// the LED's brightness doesn't change. The DMAC only interrupts when the duration channel finishes a run of notes,
+// so the CPU wakes once per run (e.g. once per round of the alarm) instead of 64 times a second. The TCC channels
+// are on higher priority DMA channels than the duration channel, so they're finished by the time its interrupt
+// fires.
+#define WATCH_BUZZER_DMA_PERIOD 0
+#define WATCH_BUZZER_DMA_DUTY 1
+#define WATCH_BUZZER_DMA_RED 2
+#define WATCH_BUZZER_DMA_GREEN 3
+#define WATCH_BUZZER_DMA_BLUE 4
+#define WATCH_BUZZER_DMA_TICKS 5
+#define WATCH_BUZZER_DMA_CHANNELS 6
+
+static DmacDescriptor _dmac_descriptors[WATCH_BUZZER_DMA_CHANNELS] __attribute__((aligned(16)));
+static DmacDescriptor _dmac_writeback[WATCH_BUZZER_DMA_CHANNELS] __attribute__((aligned(16)));
+static bool _dmac_initialized = false;
+
+// One more entry than the timeline has notes: a silent note at the end, whose loading marks the end of the last one.
+static watch_buzzer_timeline_t _timeline;
+static uint32_t _timeline_period[WATCH_BUZZER_TIMELINE_MAX_NOTES + 1];
+static uint32_t _timeline_duty[WATCH_BUZZER_TIMELINE_MAX_NOTES + 1];
+static uint32_t _timeline_led[3][WATCH_BUZZER_TIMELINE_MAX_NOTES + 1];
+static uint16_t _timeline_ticks[WATCH_BUZZER_TIMELINE_MAX_NOTES + 1];
+static volatile bool _timeline_is_playing = false;
+static uint8_t _timeline_run, _timeline_times_left;
+#endif
+
 static void _tcc_write_RUNSTDBY(bool value) {
     // enables or disables RUNSTDBY of the tcc
     tcc_disable(0);
@@ -101,8 +137,14 @@ void watch_buzzer_play_sequence_with_volume(int8_t *note_sequence, void (*callba
     _seq_position = 0;
     _tone_ticks = 0;
     _repeat_counter = -1;
-    // prepare buzzer
-    
+
+#ifdef WATCH_BUZZER_DMA
+    if (_watch_buzzer_timeline_start(note_sequence)) {
+        return;
+    }
+
+    // too long or too loopy for a timeline; read it note by note instead.
+#endif
     _cb_tc0 = cb_watch_buzzer_seq;
     // setup TC0 timer
     _tc0_initialize();
@@ -148,6 +190,185 @@ void cb_watch_buzzer_seq(void) {
     } else _tone_ticks--;
 }
 
+#ifdef WATCH_BUZZER_DMA
+static void _watch_buzzer_dmac_initialize(void) {
+    /// FIXME: #SecondMovement, we need a gossamer wrapper for the DMAC too.
+    static const struct {
+        uint8_t channel;
+        uint16_t beat_size;
+        volatile void *destination;
+    } channels[] = {
+        {WATCH_BUZZER_DMA_PERIOD, DMAC_BTCTRL_BEATSIZE_WORD, &TCC0->PERBUF.reg},
+        {WATCH_BUZZER_DMA_DUTY, DMAC_BTCTRL_BEATSIZE_WORD, &TCC0->CCBUF[(WATCH_BUZZER_TCC_CHANNEL) % 4].reg},
+        {WATCH_BUZZER_DMA_RED, DMAC_BTCTRL_BEATSIZE_WORD, &TCC0->CCBUF[(WATCH_RED_TCC_CHANNEL) % 4].reg},
+#ifdef WATCH_GREEN_TCC_CHANNEL
+        {WATCH_BUZZER_DMA_GREEN, DMAC_BTCTRL_BEATSIZE_WORD, &TCC0->CCBUF[(WATCH_GREEN_TCC_CHANNEL) % 4].reg},
+#endif
+#ifdef WATCH_BLUE_TCC_CHANNEL
+        {WATCH_BUZZER_DMA_BLUE, DMAC_BTCTRL_BEATSIZE_WORD, &TCC0->CCBUF[(WATCH_BLUE_TCC_CHANNEL) % 4].reg},
+#endif
+        {WATCH_BUZZER_DMA_TICKS, DMAC_BTCTRL_BEATSIZE_HWORD, &TC0->COUNT16.CC[0].reg},
+    };
+
+    MCLK->AHBMASK.reg |= MCLK_AHBMASK_DMAC;
+    DMAC->CTRL.reg = DMAC_CTRL_SWRST;
+    while (DMAC->CTRL.reg & DMAC_CTRL_SWRST);
+    DMAC->BASEADDR.reg = (uint32_t)_dmac_descriptors;
+    DMAC->WRBADDR.reg = (uint32_t)_dmac_writeback;
+    DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN0;
+
+    for (uint8_t i = 0; i < sizeof(channels) / sizeof(channels[0]); i++) {
+        uint8_t channel = channels[i].channel;
+        bool last = channel == WATCH_BUZZER_DMA_TICKS;
+
+        // one beat per TC0 overflow, from consecutive entries of a timeline array to the same register.
+        _dmac_descriptors[channel].BTCTRL.reg = DMAC_BTCTRL_VALID | channels[i].beat_size | DMAC_BTCTRL_SRCINC |
+                                                (last ? DMAC_BTCTRL_BLOCKACT_INT : DMAC_BTCTRL_BLOCKACT_NOACT);
+        _dmac_descriptors[channel].DSTADDR.reg = (uint32_t)channels[i].destination;
+        _dmac_descriptors[channel].DESCADDR.reg = 0;
+
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+        while (DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST);
+        DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGSRC(TC0_DMAC_ID_OVF) | DMAC_CHCTRLB_TRIGACT_BEAT;
+        if (last) DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+    }
+
+    NVIC_ClearPendingIRQ(DMAC_IRQn);
+    NVIC_EnableIRQ(DMAC_IRQn);
+    _dmac_initialized = true;
+}
+
+static void _watch_buzzer_dma_arm(uint8_t channel, const void *source, uint8_t beat_bytes, uint8_t first, uint8_t count) {
+    // with SRCINC, the DMAC wants the address just past the last beat.
+    _dmac_descriptors[channel].SRCADDR.reg = (uint32_t)source + (first + count) * beat_bytes;
+    _dmac_descriptors[channel].BTCNT.reg = count;
+    DMAC->CHID.reg = DMAC_CHID_ID(channel);
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE | DMAC_CHCTRLA_RUNSTDBY;
+}
+
+static void _watch_buzzer_timeline_arm(uint8_t first, uint8_t count) {
+    _watch_buzzer_dma_arm(WATCH_BUZZER_DMA_PERIOD, _timeline_period, sizeof(uint32_t), first, count);
+    _watch_buzzer_dma_arm(WATCH_BUZZER_DMA_DUTY, _timeline_duty, sizeof(uint32_t), first, count);
+    _watch_buzzer_dma_arm(WATCH_BUZZER_DMA_RED, _timeline_led[0], sizeof(uint32_t), first, count);
+#ifdef WATCH_GREEN_TCC_CHANNEL
+    _watch_buzzer_dma_arm(WATCH_BUZZER_DMA_GREEN, _timeline_led[1], sizeof(uint32_t), first, count);
+#endif
+#ifdef WATCH_BLUE_TCC_CHANNEL
+    _watch_buzzer_dma_arm(WATCH_BUZZER_DMA_BLUE, _timeline_led[2], sizeof(uint32_t), first, count);
+#endif
+    _watch_buzzer_dma_arm(WATCH_BUZZER_DMA_TICKS, _timeline_ticks, sizeof(uint16_t), first, count);
+}
+
+static void _watch_buzzer_timeline_next_run(void) {
+    // called to arm the first run, and then from the DMAC interrupt once the last note of each run has been loaded.
+    while (_timeline_run < _timeline.num_runs && _timeline_times_left == 0) {
+        _timeline_run++;
+        if (_timeline_run < _timeline.num_runs) _timeline_times_left = _timeline.runs[_timeline_run].times;
+    }
+
+    if (_timeline_run < _timeline.num_runs) {
+        _timeline_times_left--;
+        _watch_buzzer_timeline_arm(_timeline.runs[_timeline_run].first, _timeline.runs[_timeline_run].count);
+    } else if (_timeline_run == _timeline.num_runs) {
+        // the silent note at the end; it gets loaded when the last real note ends.
+        _timeline_run++;
+        _watch_buzzer_timeline_arm(_timeline.num_notes, 1);
+    } else {
+        watch_buzzer_abort_sequence();
+    }
+}
+
+static void _watch_buzzer_timeline_set_led_duty_cycles(void) {
+    // the same scaling as _watch_set_led_duty_cycle, for every note's period.
+    for (uint8_t i = 0; i <= _timeline.num_notes; i++) {
+        for (uint8_t led = 0; led < 3; led++) {
+            uint32_t color = _led_is_active ? _current_led_color[led] : 0;
+            _timeline_led[led][i] = (_timeline_period[i] * color * 1000ull) / 255000ull;
+        }
+    }
+}
+
+static bool _watch_buzzer_timeline_start(int8_t *note_sequence) {
+    uint32_t period = tcc_get_period(0);
+
+    if (!watch_buzzer_compile_sequence(note_sequence, &_timeline)) {
+        return false;
+    }
+
+    // a rest keeps the period of the note before it, so the LED doesn't flicker, and just has no duty cycle.
+    for (uint8_t i = 0; i < _timeline.num_notes; i++) {
+        if (_timeline.period[i] != WATCH_BUZZER_PERIOD_REST) {
+            period = _timeline.period[i];
+            _timeline_duty[i] = period / (100 / _volume);
+        } else {
+            _timeline_duty[i] = 0;
+        }
+        _timeline_period[i] = period;
+        _timeline_ticks[i] = _timeline.duration[i] - 1;
+    }
+    _timeline_period[_timeline.num_notes] = period;
+    _timeline_duty[_timeline.num_notes] = 0;
+    _timeline_ticks[_timeline.num_notes] = 0;
+    _watch_buzzer_timeline_set_led_duty_cycles();
+
+    if (!_dmac_initialized) {
+        _watch_buzzer_dmac_initialize();
+    }
+
+    // TC0 counts 64 Hz ticks up to CC0, which the DMAC sets to each note's duration less one. Starting it at zero
+    // means the first overflow, which loads the first note, comes one tick from now.
+    tc_init(0, GENERIC_CLOCK_3, TC_PRESCALER_DIV16);
+    tc_set_counter_mode(0, TC_COUNTER_MODE_16BIT);
+    tc_set_run_in_standby(0, true);
+    /// FIXME: #SecondMovement, gossamer has no wrapper for the match frequency mode or 16-bit compare values.
+    TC0->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+    TC0->COUNT16.CC[0].reg = 0;
+    TC0->COUNT16.INTENCLR.reg = TC_INTENCLR_OVF;
+
+    // the pin stays on the TCC for the whole sequence; rests just have no duty cycle.
+    watch_set_buzzer_period_and_duty_cycle(period, _volume);
+    tcc_set_cc(0, (WATCH_BUZZER_TCC_CHANNEL) % 4, 0, true);
+    watch_set_buzzer_on();
+
+    _timeline_is_playing = true;
+    _timeline_run = 0;
+    _timeline_times_left = _timeline.num_runs ? _timeline.runs[0].times : 0;
+    _watch_buzzer_timeline_next_run();
+    _cb_tc0 = NULL;
+    _tc0_start();
+
+    return true;
+}
+
+static void _watch_buzzer_timeline_stop(void) {
+    if (!_timeline_is_playing) {
+        return;
+    }
+
+    _timeline_is_playing = false;
+    NVIC_DisableIRQ(DMAC_IRQn);
+    for (uint8_t channel = 0; channel < WATCH_BUZZER_DMA_CHANNELS; channel++) {
+        DMAC->CHID.reg = DMAC_CHID_ID(channel);
+        DMAC->CHCTRLA.reg = 0;
+        DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+    }
+    NVIC_ClearPendingIRQ(DMAC_IRQn);
+    NVIC_EnableIRQ(DMAC_IRQn);
+}
+
+void irq_handler_dmac(void) {
+    // interrupt handler for the DMAC; only the buzzer's duration channel raises one.
+    DMAC->CHID.reg = DMAC_CHID_ID(WATCH_BUZZER_DMA_TICKS);
+    if (DMAC->CHINTFLAG.reg & DMAC_CHINTFLAG_TCMPL) {
+        DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
+        if (_timeline_is_playing) {
+            _watch_buzzer_timeline_next_run();
+        }
+    }
+}
+#endif // WATCH_BUZZER_DMA
+
 void watch_buzzer_play_raw_source(watch_buzzer_raw_source_t raw_source, void* userdata, watch_cb_t callback_on_end) {
     watch_buzzer_play_raw_source_with_volume(raw_source, userdata, callback_on_end, WATCH_BUZZER_VOLUME_LOUD);
 }
@@ -214,6 +435,9 @@ void watch_buzzer_abort_sequence(void) {
     }
 
     _tc0_stop();
+#ifdef WATCH_BUZZER_DMA
+    _watch_buzzer_timeline_stop();
+#endif
 
     watch_set_buzzer_off();
 
@@ -454,6 +678,13 @@ void watch_set_led_color_rgb(uint8_t red, uint8_t green, uint8_t blue) {
         }
         watch_disable_leds();
     }
+
+#ifdef WATCH_BUZZER_DMA
+    // a playing timeline reloads the LED duty cycles with every note, so it needs the new color too.
+    if (_timeline_is_playing) {
+        _watch_buzzer_timeline_set_led_duty_cycles();
+    }
+#endif
 }
 
 void watch_set_led_red(void) {
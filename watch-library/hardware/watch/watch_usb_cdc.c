@@ -24,11 +24,12 @@
  */
 
 #include <stddef.h>
+#include <string.h>
 #include "watch_usb_cdc.h"
 #include "tusb.h"
 
 /*
- * Implement a circular buffer for the USB CDC Serial read buffer.
+ * Implement circular buffers for the USB CDC Serial write and read buffers.
  * The size of the buffer must be a power of two for this circular buffer
  * implementation to work.
  */
@@ -48,6 +49,18 @@ static char s_read_buf[CDC_READ_BUF_SZ] = {0};
 static size_t s_read_buf_pos = 0;
 static size_t s_read_buf_len = 0;
 
+static bool s_writing = false;
+
+static void prv_handle_reads(void);
+static void prv_handle_writes(void);
+
+// Whether _write can wait for the host to drain the buffer. It can't if nobody
+// is listening, if we're in an interrupt (tud_task has to run from the main
+// loop), or if we're already inside cdc_task.
+static bool prv_can_wait(void) {
+    return tud_cdc_connected() && __get_IPSR() == 0 && !s_writing;
+}
+
 int _write(int file, char *ptr, int len) {
     (void) file;
 
@@ -57,13 +70,40 @@ int _write(int file, char *ptr, int len) {
 
     int bytes_written = 0;
 
-    for (int i = 0; i < len; i++) {
-        s_write_buf[s_write_buf_pos] = ptr[i];
-        s_write_buf_pos = CDC_WRITE_BUF_IDX(s_write_buf_pos + 1);
-        if (s_write_buf_len < CDC_WRITE_BUF_SZ) {
-            s_write_buf_len++;
+    while (bytes_written < len) {
+        size_t remaining = len - bytes_written;
+
+        if (s_write_buf_len == 0 && prv_can_wait()) {
+            // Nothing queued ahead of us, so hand as much as the FIFO will
+            // take straight to TinyUSB without copying it into the ring.
+            uint32_t available = tud_cdc_write_available();
+            if (available > 0) {
+                bytes_written += tud_cdc_write(ptr + bytes_written, remaining < available ? remaining : available);
+                continue;
+            }
         }
-        bytes_written++;
+
+        size_t space = CDC_WRITE_BUF_SZ - s_write_buf_len;
+        if (space == 0) {
+            if (prv_can_wait()) {
+                // Back pressure: let the host catch up instead of dropping.
+                tud_task();
+                cdc_task();
+                continue;
+            }
+            // Nobody to wait for; make room by dropping the oldest byte.
+            s_write_buf_len--;
+            space = 1;
+        }
+
+        // Copy up to the end of the ring in one go; the next pass wraps.
+        size_t chunk = CDC_WRITE_BUF_SZ - s_write_buf_pos;
+        if (chunk > space) chunk = space;
+        if (chunk > remaining) chunk = remaining;
+        memcpy(&s_write_buf[s_write_buf_pos], ptr + bytes_written, chunk);
+        s_write_buf_pos = CDC_WRITE_BUF_IDX(s_write_buf_pos + chunk);
+        s_write_buf_len += chunk;
+        bytes_written += chunk;
     }
 
     return bytes_written;
@@ -111,25 +151,32 @@ static void prv_handle_reads(void) {
 }
 
 static void prv_handle_writes(void) {
-    if (s_write_buf_len > 0) {
+    s_writing = true;
+    while (s_write_buf_len > 0) {
+        if (tud_cdc_available() > 0) {
+            // If we receive data while doing a large write, we need to
+            // fully service it before continuing to write, or the
+            // stack will crash.
+            prv_handle_reads();
+        }
+
+        // Hand TinyUSB the contiguous run from the oldest byte to the end of
+        // the ring (or of the data); a wrapped buffer takes two passes.
         const size_t start_pos =
             CDC_WRITE_BUF_IDX(s_write_buf_pos - s_write_buf_len);
-        for (size_t i = 0; i < (size_t) s_write_buf_len; i++) {
-            const size_t idx = CDC_WRITE_BUF_IDX(start_pos + i);
-            if (tud_cdc_available() > 0) {
-                // If we receive data while doing a large write, we need to
-                // fully service it before continuing to write, or the
-                // stack will crash.
-                prv_handle_reads();
-            }
-            if (tud_cdc_write_available()) {
-                tud_cdc_write(&s_write_buf[idx], 1);
-            }
-            s_write_buf[idx] = 0;
-            s_write_buf_len--;
+        size_t chunk = CDC_WRITE_BUF_SZ - start_pos;
+        if (chunk > s_write_buf_len) {
+            chunk = s_write_buf_len;
+        }
+        uint32_t written = tud_cdc_write(&s_write_buf[start_pos], chunk);
+        s_write_buf_len -= written;
+        if (written < chunk) {
+            // The FIFO is full. Keep the rest for next time.
+            break;
         }
-        tud_cdc_write_flush();
     }
+    tud_cdc_write_flush();
+    s_writing = false;
 }
 
 void cdc_task(void) {
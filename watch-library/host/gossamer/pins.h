@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file pins.h
+
+/* Host stand-in for gossamer's board pins.h. Pin levels live in two 32-bit
+ * words (one per port) so that Movement, the drivers and the host harness all
+ * see the same state. Pin numbers follow the Sensor Watch boards where it
+ * matters; otherwise they only need to be unique.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define GPIO_PORTA 0
+#define GPIO_PORTB 1
+#define GPIO(port, pin) ((((port) & 0x7u) << 5) + ((pin) & 0x1fu))
+
+#define HAL_GPIO_PORTA 0
+#define HAL_GPIO_PORTB 1
+
+#define HAL_GPIO_PMUX_EIC      0
+#define HAL_GPIO_PMUX_ADC      1
+#define HAL_GPIO_PMUX_SERCOM   2
+#define HAL_GPIO_PMUX_SERCOM_ALT 3
+#define HAL_GPIO_PMUX_TC       4
+#define HAL_GPIO_PMUX_TCC      5
+#define HAL_GPIO_PMUX_COM      6
+#define HAL_GPIO_PMUX_RTC      7
+#define HAL_GPIO_PMUX_SLCD     8
+
+extern volatile uint32_t _host_gpio_level[2];
+extern volatile uint32_t _host_gpio_output[2];
+
+#define HAL_GPIO_PIN(name, port, pin) \
+    static inline void HAL_GPIO_##name##_set(void) { _host_gpio_level[HAL_GPIO_PORT##port] |= (1u << (pin)); } \
+    static inline void HAL_GPIO_##name##_clr(void) { _host_gpio_level[HAL_GPIO_PORT##port] &= ~(1u << (pin)); } \
+    static inline void HAL_GPIO_##name##_toggle(void) { _host_gpio_level[HAL_GPIO_PORT##port] ^= (1u << (pin)); } \
+    static inline void HAL_GPIO_##name##_write(int value) { if (value) HAL_GPIO_##name##_set(); else HAL_GPIO_##name##_clr(); } \
+    static inline void HAL_GPIO_##name##_in(void) { _host_gpio_output[HAL_GPIO_PORT##port] &= ~(1u << (pin)); } \
+    static inline void HAL_GPIO_##name##_out(void) { _host_gpio_output[HAL_GPIO_PORT##port] |= (1u << (pin)); } \
+    static inline void HAL_GPIO_##name##_off(void) { _host_gpio_output[HAL_GPIO_PORT##port] &= ~(1u << (pin)); } \
+    static inline void HAL_GPIO_##name##_pullup(void) {} \
+    static inline void HAL_GPIO_##name##_pulldown(void) {} \
+    static inline void HAL_GPIO_##name##_drvstr(int drvstr) { (void)drvstr; } \
+    static inline void HAL_GPIO_##name##_pmuxen(int mux) { (void)mux; } \
+    static inline void HAL_GPIO_##name##_pmuxdis(void) {} \
+    static inline bool HAL_GPIO_##name##_read(void) { return (_host_gpio_level[HAL_GPIO_PORT##port] & (1u << (pin))) != 0; } \
+    static inline bool HAL_GPIO_##name##_state(void) { return (_host_gpio_output[HAL_GPIO_PORT##port] & (1u << (pin))) != 0; } \
+    static inline uint8_t HAL_GPIO_##name##_pin(void) { return GPIO(HAL_GPIO_PORT##port, pin); }
+
+// Buttons
+HAL_GPIO_PIN(BTN_LIGHT, A, 22)
+HAL_GPIO_PIN(BTN_MODE, A, 23)
+HAL_GPIO_PIN(BTN_ALARM, A, 2)
+
+// Buzzer and LED
+HAL_GPIO_PIN(BUZZER, A, 27)
+HAL_GPIO_PIN(RED, A, 20)
+HAL_GPIO_PIN(GREEN, A, 21)
+HAL_GPIO_PIN(BLUE, A, 19)
+
+// Nine-pin connector
+HAL_GPIO_PIN(A0, B, 4)
+HAL_GPIO_PIN(A1, B, 1)
+HAL_GPIO_PIN(A2, B, 2)
+HAL_GPIO_PIN(A3, B, 3)
+HAL_GPIO_PIN(A4, B, 0)
+HAL_GPIO_PIN(SDA, B, 30)
+HAL_GPIO_PIN(SCL, B, 31)
+
+// Sensors and board housekeeping
+HAL_GPIO_PIN(TEMPSENSE, A, 3)
+HAL_GPIO_PIN(TS_ENABLE, B, 23)
+HAL_GPIO_PIN(IRSENSE, A, 4)
+HAL_GPIO_PIN(IR_ENABLE, B, 22)
+HAL_GPIO_PIN(VBUS_DET, A, 31)
+
+#if defined(WATCH_HOST_BOARD_RED)
+#define WATCH_RED_TCC_CHANNEL 0
+#define WATCH_GREEN_TCC_CHANNEL 1
+#elif defined(WATCH_HOST_BOARD_GREEN)
+#define WATCH_RED_TCC_CHANNEL 0
+#define WATCH_GREEN_TCC_CHANNEL 1
+#define I2C_SERCOM 1
+#elif defined(WATCH_HOST_BOARD_BLUE)
+#define WATCH_RED_TCC_CHANNEL 0
+#define WATCH_BLUE_TCC_CHANNEL 1
+#define I2C_SERCOM 1
+#elif defined(WATCH_HOST_BOARD_PRO)
+#define WATCH_RED_TCC_CHANNEL 0
+#define WATCH_GREEN_TCC_CHANNEL 1
+#define WATCH_BLUE_TCC_CHANNEL 2
+#define I2C_SERCOM 1
+#endif
@@ -0,0 +1,36 @@
+# Host build: compiles Movement and the watch faces into a native executable that runs against
+# a virtual clock. This stands in for gossamer's make.mk, so the firmware's BOARD and DISPLAY
+# options carry over unchanged:
+#
+#     make HOST=1 BOARD=sensorwatch_pro DISPLAY=classic
+#     ./build-host/movement -d 7
+
+BUILD = ./build-host
+BIN = movement
+
+CFLAGS += -std=gnu17 -g -O2
+CFLAGS += -Wall -Wextra -Wno-unused-parameter -Wno-missing-field-initializers -Wno-sign-compare
+# Firmware code prints 32-bit integers with %ld, which is right on the SAM L22 but not on a 64-bit host.
+CFLAGS += -Wno-format
+CFLAGS += -fno-common
+
+LIBS += -lm -ldl
+
+# Export the firmware's symbols so the energy report can name watch faces by their functions.
+LDFLAGS += -rdynamic
+
+DEFINES += -DWATCH_HOST
+DEFINES += -DBUILD_GIT_HASH=\"$(shell git rev-parse --short=6 HEAD 2>/dev/null)\"
+
+ifeq ($(BOARD), sensorwatch_red)
+  DEFINES += -DWATCH_HOST_BOARD_RED
+else ifeq ($(BOARD), sensorwatch_green)
+  DEFINES += -DWATCH_HOST_BOARD_GREEN
+else ifeq ($(BOARD), sensorwatch_blue)
+  DEFINES += -DWATCH_HOST_BOARD_BLUE
+else ifeq ($(BOARD), sensorwatch_pro)
+  DEFINES += -DWATCH_HOST_BOARD_PRO
+endif
+
+INCLUDES += \
+  -I./watch-library/host/gossamer \
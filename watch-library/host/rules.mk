@@ -0,0 +1,32 @@
+# Host build rules; see make.mk in this directory.
+
+# These faces drive SAM L22 peripherals directly (ADC, SERCOM, raw registers) rather than going
+# through the watch library, so they can't run on the host.
+HOST_UNSUPPORTED_SRCS = \
+  ./watch-faces/demo/light_sensor_face.c \
+  ./watch-faces/demo/peek_memory_face.c \
+  ./watch-faces/io/irda_upload_face.c \
+
+SRCS := $(filter-out $(HOST_UNSUPPORTED_SRCS) ./dummy.c,$(SRCS))
+
+OBJS = $(patsubst ./%.c,$(BUILD)/%.o,$(SRCS))
+DEPS = $(OBJS:.o=.d)
+
+all: $(BUILD)/$(BIN)
+
+$(BUILD)/$(BIN): $(OBJS)
+	@echo LD $@
+	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@
+
+$(BUILD)/%.o: %.c
+	@echo CC $@
+	@mkdir -p $(dir $@)
+	@$(CC) $(CFLAGS) $(DEFINES) $(INCLUDES) -MD -MP -c $< -o $@
+
+clean:
+	@echo clean
+	@-rm -rf $(BUILD)
+
+-include $(DEPS)
+
+.PHONY: all clean
@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "watch_adc.h"
+#include "thermistor_driver.h"
+#include "watch_host_energy.h"
+
+static bool _adc_enabled = false;
+
+void watch_enable_adc(void) {
+    _adc_enabled = true;
+    _watch_host_energy_set_adc_enabled(true);
+}
+
+void watch_enable_analog_input(const uint16_t pin) {}
+
+uint16_t watch_get_analog_pin_level(const uint16_t pin) {
+    if (!_adc_enabled) return 0;
+
+    _watch_host_energy_adc_read();
+
+    if (pin == HAL_GPIO_TEMPSENSE_pin()) {
+        // Emulate a thermistor board at its nominal temperature: with the divider powered, the
+        // thermistor and series resistor are equal and we read half scale. With it unpowered,
+        // both ends of the divider sit at the same potential.
+        if (HAL_GPIO_TS_ENABLE_read() == THERMISTOR_ENABLE_VALUE) return 32767;
+        return THERMISTOR_ENABLE_VALUE ? 0 : 65535;
+    }
+
+    return 32767; // pretend it's half of VCC
+}
+
+uint16_t watch_get_vcc_voltage(void) {
+    _watch_host_energy_adc_read();
+    return 3000;
+}
+
+void watch_disable_analog_input(const uint16_t pin) {}
+
+void watch_disable_adc(void) {
+    _adc_enabled = false;
+    _watch_host_energy_set_adc_enabled(false);
+}
@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "watch_deepsleep.h"
+#include "watch_host.h"
+#include "watch_host_energy.h"
+#include "app.h"
+
+static uint32_t watch_backup_data[8];
+
+// The RTC tamper inputs are level-sensitive; we keep the configured level per pin.
+static bool _btn_alarm_level;
+static bool _a2_level;
+static bool _a4_level;
+
+void watch_register_extwake_callback(uint8_t pin, watch_cb_t callback, bool level) {
+    if (pin == HAL_GPIO_BTN_ALARM_pin()) {
+        HAL_GPIO_BTN_ALARM_in();
+        btn_alarm_callback = callback;
+        _btn_alarm_level = level;
+    } else if (pin == HAL_GPIO_A2_pin()) {
+        HAL_GPIO_A2_in();
+        a2_callback = callback;
+        _a2_level = level;
+    } else if (pin == HAL_GPIO_A4_pin()) {
+        HAL_GPIO_A4_in();
+        a4_callback = callback;
+        _a4_level = level;
+    }
+}
+
+void watch_disable_extwake_interrupt(uint8_t pin) {
+    if (pin == HAL_GPIO_BTN_ALARM_pin()) {
+        btn_alarm_callback = NULL;
+    } else if (pin == HAL_GPIO_A2_pin()) {
+        a2_callback = NULL;
+    } else if (pin == HAL_GPIO_A4_pin()) {
+        a4_callback = NULL;
+    }
+}
+
+void _watch_host_extwake_edge(uint8_t pin, bool level) {
+    watch_cb_t callback = NULL;
+
+    if (pin == HAL_GPIO_BTN_ALARM_pin() && level == _btn_alarm_level) {
+        callback = btn_alarm_callback;
+    } else if (pin == HAL_GPIO_A2_pin() && level == _a2_level) {
+        callback = a2_callback;
+    } else if (pin == HAL_GPIO_A4_pin() && level == _a4_level) {
+        callback = a4_callback;
+    }
+
+    if (callback != NULL) {
+        _watch_host_interrupt();
+        callback();
+    }
+}
+
+void watch_store_backup_data(uint32_t data, uint8_t reg) {
+    if (reg < 8) {
+        watch_backup_data[reg] = data;
+    }
+}
+
+uint32_t watch_get_backup_data(uint8_t reg) {
+    if (reg < 8) {
+        return watch_backup_data[reg];
+    }
+
+    return 0;
+}
+
+void watch_enter_sleep_mode(void) {
+    // disable all other peripherals
+    watch_disable_leds();
+    watch_disable_buzzer();
+    watch_disable_adc();
+    watch_disable_external_interrupts();
+
+    // disable tick interrupt
+    watch_rtc_disable_all_periodic_callbacks();
+
+    // enter standby (4); we basically hang out here until an interrupt wakes us.
+    sleep(4);
+
+    // call app_setup so the app can re-enable everything we disabled.
+    app_setup();
+}
+
+void watch_enter_backup_mode(void) {
+    watch_rtc_disable_all_periodic_callbacks();
+
+    // go into backup sleep mode (5). There is no reset controller to take over on the host,
+    // so the best we can do is sleep until something wakes us.
+    _watch_host_energy_set_backup_mode(true);
+    sleep(5);
+    _watch_host_energy_set_backup_mode(false);
+}
+
+void sleep(const uint8_t mode) {
+    (void) mode;
+
+    // like WFI: advance the virtual clock until an interrupt fires.
+    watch_host_wait_for_interrupt();
+}
@@ -0,0 +1,59 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stddef.h>
+
+#include "watch_extint.h"
+#include "watch_host.h"
+
+// The EIC has 16 channels, but on the host we can simply index by pin.
+#define WATCH_HOST_N_PINS 64
+
+static bool _external_interrupts_enabled = false;
+static watch_cb_t _eic_callbacks[WATCH_HOST_N_PINS];
+static eic_interrupt_trigger_t _eic_triggers[WATCH_HOST_N_PINS];
+
+void watch_enable_external_interrupts(void) {
+    _external_interrupts_enabled = true;
+}
+
+void watch_disable_external_interrupts(void) {
+    _external_interrupts_enabled = false;
+}
+
+void watch_register_interrupt_callback(const uint8_t pin, watch_cb_t callback, eic_interrupt_trigger_t trigger) {
+    if (pin >= WATCH_HOST_N_PINS) return;
+
+    _eic_callbacks[pin] = callback;
+    _eic_triggers[pin] = trigger;
+}
+
+void _watch_host_eic_edge(uint8_t pin, bool level) {
+    if (!_external_interrupts_enabled || pin >= WATCH_HOST_N_PINS) return;
+
+    eic_interrupt_trigger_t event = level ? INTERRUPT_TRIGGER_RISING : INTERRUPT_TRIGGER_FALLING;
+    if (_eic_callbacks[pin] != NULL && (event & _eic_triggers[pin]) != 0) {
+        _watch_host_interrupt();
+        _eic_callbacks[pin]();
+    }
+}
@@ -0,0 +1,279 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "watch.h"
+#include "watch_host.h"
+#include "watch_host_energy.h"
+#include "app.h"
+#include "delay.h"
+
+#define WATCH_HOST_TICKS_PER_SECOND 128
+#define WATCH_HOST_MAX_SCRIPT_EVENTS 64
+
+typedef struct {
+    uint64_t tick;
+    uint8_t pin;
+    bool level;
+} watch_host_script_event_t;
+
+static uint64_t _elapsed_ticks;
+static uint64_t _end_ticks;
+static volatile bool _interrupt_pending;
+static uint64_t _wakeups;
+static uint64_t _app_loops;
+static uint64_t _steps;
+static const char *_storage_path;
+static bool _energy_report;
+
+static watch_host_script_event_t _script[WATCH_HOST_MAX_SCRIPT_EVENTS];
+static uint8_t _script_len;
+static uint8_t _script_pos;
+
+static void _watch_host_finish(void) {
+    if (_storage_path) watch_host_storage_save(_storage_path);
+
+    printf("simulated %llu s: %llu wakeups, %llu app_loop calls, %llu of %llu ticks stepped\n",
+           (unsigned long long)(_elapsed_ticks / WATCH_HOST_TICKS_PER_SECOND),
+           (unsigned long long)_wakeups,
+           (unsigned long long)_app_loops,
+           (unsigned long long)_steps,
+           (unsigned long long)_elapsed_ticks);
+
+    if (_energy_report) watch_host_energy_print_report();
+
+    exit(0);
+}
+
+static void _watch_host_step(void) {
+    if (_elapsed_ticks >= _end_ticks) _watch_host_finish();
+
+    _elapsed_ticks++;
+    _steps++;
+    _watch_host_rtc_tick();
+    // TC0 is clocked at 64 Hz, i.e. it overflows on every other RTC tick.
+    if ((_elapsed_ticks & 1) == 0) _watch_host_tc0_tick();
+
+    while (_script_pos < _script_len && _script[_script_pos].tick <= _elapsed_ticks) {
+        watch_host_set_pin_level(_script[_script_pos].pin, _script[_script_pos].level);
+        _script_pos++;
+    }
+}
+
+/// Returns how many of the next ticks are guaranteed not to raise an interrupt or change a pin.
+static uint64_t _watch_host_idle_ticks(void) {
+    // TC0 overflows every other tick, so there is nothing to gain while the buzzer is playing.
+    if (_watch_host_tc0_is_running()) return 0;
+
+    uint64_t idle = _end_ticks - _elapsed_ticks;
+
+    uint32_t rtc = _watch_host_rtc_ticks_until_next_event();
+    if (rtc && rtc - 1 < idle) idle = rtc - 1;
+
+    if (_script_pos < _script_len) {
+        uint64_t script = _script[_script_pos].tick - _elapsed_ticks;
+        if (_script[_script_pos].tick <= _elapsed_ticks) script = 1;
+        if (script - 1 < idle) idle = script - 1;
+    }
+
+    return idle;
+}
+
+/// Jumps over up to max_ticks idle ticks at once, then steps the tick after them normally.
+static void _watch_host_warp(uint64_t max_ticks) {
+    uint64_t idle = _watch_host_idle_ticks();
+    if (idle >= max_ticks) idle = max_ticks - 1;
+
+    // Nothing can happen in between, so skipping straight over them is indistinguishable from
+    // stepping one tick at a time; only the next (eventful) tick is stepped.
+    if (idle) {
+        _elapsed_ticks += idle;
+        _watch_host_rtc_skip((uint32_t)idle);
+    }
+    _watch_host_step();
+}
+
+void _watch_host_interrupt(void) {
+    _interrupt_pending = true;
+}
+
+void watch_host_advance(uint32_t ticks) {
+    uint64_t target = _elapsed_ticks + ticks;
+    while (_elapsed_ticks < target) _watch_host_warp(target - _elapsed_ticks);
+}
+
+void watch_host_wait_for_interrupt(void) {
+    // Interrupts are delivered synchronously, so anything that fired before we got here has
+    // already been serviced; like WFI, we only wake for new ones.
+    _interrupt_pending = false;
+    while (!_interrupt_pending) _watch_host_warp(UINT64_MAX);
+    _wakeups++;
+    _watch_host_energy_wakeup();
+}
+
+uint64_t watch_host_get_elapsed_ticks(void) {
+    return _elapsed_ticks;
+}
+
+void watch_host_set_pin_level(uint8_t pin, bool level) {
+    bool current = (_host_gpio_level[pin >> 5] >> (pin & 0x1F)) & 1;
+    if (current == level) return;
+
+    if (level) {
+        _host_gpio_level[pin >> 5] |= (1u << (pin & 0x1F));
+    } else {
+        _host_gpio_level[pin >> 5] &= ~(1u << (pin & 0x1F));
+    }
+
+    _watch_host_eic_edge(pin, level);
+    _watch_host_extwake_edge(pin, level);
+}
+
+void delay_ms(const uint16_t ms) {
+    // delay_ms busy-waits on the hardware
+    _watch_host_energy_set_cpu_running(true);
+    watch_host_advance(((uint32_t)ms * WATCH_HOST_TICKS_PER_SECOND + 999) / 1000);
+    _watch_host_energy_set_cpu_running(false);
+}
+
+static void _watch_host_add_script_event(uint64_t tick, uint8_t pin, bool level) {
+    if (_script_len >= WATCH_HOST_MAX_SCRIPT_EVENTS) return;
+
+    // keep the script sorted by tick; presses are few, so insertion sort is fine.
+    uint8_t i = _script_len++;
+    while (i > 0 && _script[i - 1].tick > tick) {
+        _script[i] = _script[i - 1];
+        i--;
+    }
+    _script[i] = (watch_host_script_event_t) { .tick = tick, .pin = pin, .level = level };
+}
+
+static bool _watch_host_parse_press(const char *arg) {
+    // BUTTON@SECONDS[/HOLD_MS], e.g. mode@10 or alarm@3600/2000
+    char button[8];
+    double seconds = 0;
+    unsigned int hold_ms = 100;
+    if (sscanf(arg, "%7[a-zA-Z]@%lf/%u", button, &seconds, &hold_ms) < 2) return false;
+
+    uint8_t pin;
+    if (strcasecmp(button, "mode") == 0) pin = HAL_GPIO_BTN_MODE_pin();
+    else if (strcasecmp(button, "light") == 0) pin = HAL_GPIO_BTN_LIGHT_pin();
+    else if (strcasecmp(button, "alarm") == 0) pin = HAL_GPIO_BTN_ALARM_pin();
+    else return false;
+
+    uint64_t down = (uint64_t)(seconds * WATCH_HOST_TICKS_PER_SECOND);
+    uint64_t up = down + ((uint64_t)hold_ms * WATCH_HOST_TICKS_PER_SECOND + 999) / 1000;
+    _watch_host_add_script_event(down, pin, true);
+    _watch_host_add_script_event(up, pin, false);
+
+    return true;
+}
+
+static void _watch_host_usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-d days] [-s seconds] [-t unix_time] [-f storage.bin] [-p button@seconds[/hold_ms]]... [-e]\n"
+            "  -d, -s  how long to simulate (default: 1 day)\n"
+            "  -t      UTC time to start the RTC at (default: now)\n"
+            "  -f      file backing the emulated NVM; loaded at start, saved at exit\n"
+            "  -p      press mode, light or alarm at the given time; may be repeated\n"
+            "  -e      print the estimated energy drawn by each watch face at exit\n",
+            name);
+}
+
+int main(int argc, char **argv) {
+    uint64_t duration = 86400;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (arg[0] != '-' || arg[1] == 0 || arg[2] != 0) {
+            _watch_host_usage(argv[0]);
+            return 1;
+        }
+
+        // the only option that doesn't take a value
+        if (arg[1] == 'e') {
+            _energy_report = true;
+            continue;
+        }
+
+        if (value == NULL) {
+            _watch_host_usage(argv[0]);
+            return 1;
+        }
+
+        switch (arg[1]) {
+            case 'd':
+                duration = strtoull(value, NULL, 10) * 86400;
+                break;
+            case 's':
+                duration = strtoull(value, NULL, 10);
+                break;
+            case 't':
+                watch_host_set_init_unix_time((uint32_t)strtoul(value, NULL, 10));
+                break;
+            case 'f':
+                _storage_path = value;
+                break;
+            case 'p':
+                if (!_watch_host_parse_press(value)) {
+                    _watch_host_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            default:
+                _watch_host_usage(argv[0]);
+                return 1;
+        }
+        i++;
+    }
+
+    _end_ticks = duration * WATCH_HOST_TICKS_PER_SECOND;
+    if (_storage_path) watch_host_storage_load(_storage_path);
+
+    // same sequence as gossamer's main.c
+    app_init();
+    app_setup();
+
+    while (true) {
+        bool can_sleep = app_loop();
+        _app_loops++;
+
+        if (can_sleep) {
+            sleep(4);
+        } else {
+            // On the hardware, a busy loop takes real time. Charge it one tick so that a face
+            // that never lets us sleep can't stall the virtual clock.
+            _watch_host_energy_set_cpu_running(true);
+            watch_host_advance(1);
+            _watch_host_energy_set_cpu_running(false);
+        }
+    }
+
+    return 0;
+}
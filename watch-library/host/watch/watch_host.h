@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file watch_host.h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @addtogroup host Host Backend
+  * @brief This section covers the native host backend, which runs Movement and its watch faces as a
+  *        plain executable against a virtual clock.
+  * @details Nothing here talks to a wall clock. Time only moves when the firmware sleeps or delays,
+  *          and every peripheral interrupt (RTC periodic and compare, external interrupts and the
+  *          64 Hz buzzer timer) is delivered synchronously from within the virtual clock. This makes
+  *          a run fully deterministic, which is what you want when profiling the firmware or checking
+  *          for regressions in CI.
+  */
+/// @{
+
+/** @brief Advances the virtual RTC by the given number of 128 Hz ticks, firing any interrupts that
+  *        come due along the way.
+  */
+void watch_host_advance(uint32_t ticks);
+
+/** @brief Advances the virtual RTC until at least one interrupt has fired. This is what the CPU's WFI
+  *        instruction does on the hardware.
+  * @note If the end of the simulated run is reached first, this function does not return: the host
+  *       backend saves its state, prints a summary and exits.
+  */
+void watch_host_wait_for_interrupt(void);
+
+/** @brief Sets the UTC time the virtual RTC starts at. Call this before app_init; if you don't, the
+  *        RTC starts at the host's current time.
+  */
+void watch_host_set_init_unix_time(uint32_t unix_time);
+
+/// @brief Returns the number of 128 Hz ticks that have elapsed since the host backend started.
+uint64_t watch_host_get_elapsed_ticks(void);
+
+/** @brief Sets the level of a button (or any other external interrupt pin) and delivers the interrupt,
+  *        if one is registered for this edge.
+  * @param pin The pin, e.g. HAL_GPIO_BTN_MODE_pin().
+  * @param level true for pressed, false for released.
+  */
+void watch_host_set_pin_level(uint8_t pin, bool level);
+
+/** @brief Reads back a segment from the display's shadow memory.
+  * @return true if the segment at the given COM and SEG line is on.
+  */
+bool watch_host_get_pixel(uint8_t com, uint8_t seg);
+
+/// @brief Loads the contents of the emulated NVM from a file, if it exists.
+bool watch_host_storage_load(const char *path);
+
+/// @brief Saves the contents of the emulated NVM to a file.
+bool watch_host_storage_save(const char *path);
+
+/// @}
+
+/// Called by the peripheral emulation whenever an interrupt handler runs. You should not call this from your app.
+void _watch_host_interrupt(void);
+
+/// Steps the virtual RTC by one tick. Implemented in watch_rtc.c; you should not call this from your app.
+void _watch_host_rtc_tick(void);
+
+/** Returns how many ticks from now the virtual RTC will next raise an interrupt (at least 1), or 0 if
+  * no periodic or compare interrupt is enabled. Implemented in watch_rtc.c; you should not call this
+  * from your app.
+  */
+uint32_t _watch_host_rtc_ticks_until_next_event(void);
+
+/// Moves the virtual RTC forward without firing anything. Implemented in watch_rtc.c; you should not call this from your app.
+void _watch_host_rtc_skip(uint32_t ticks);
+
+/// Returns true if the buzzer's 64 Hz sequencer is running. Implemented in watch_tcc.c; you should not call this from your app.
+bool _watch_host_tc0_is_running(void);
+
+/// Steps the buzzer's 64 Hz sequencer by one tick. Implemented in watch_tcc.c; you should not call this from your app.
+void _watch_host_tc0_tick(void);
+
+/// Delivers an edge on an EIC pin. Implemented in watch_extint.c; you should not call this from your app.
+void _watch_host_eic_edge(uint8_t pin, bool level);
+
+/// Delivers an edge on an RTC tamper (extwake) pin. Implemented in watch_deepsleep.c; you should not call this from your app.
+void _watch_host_extwake_edge(uint8_t pin, bool level);
@@ -0,0 +1,278 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _GNU_SOURCE // for dladdr
+#include <dlfcn.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "watch_host.h"
+#include "watch_host_energy.h"
+
+#define WATCH_HOST_ENERGY_MAX_FACES 64
+#define WATCH_HOST_ENERGY_TICKS_PER_HOUR (128.0 * 3600.0)
+#define WATCH_HOST_ENERGY_HOURS_PER_DAY 24.0
+
+typedef struct {
+    const char *board;
+    float standby_ua;           // MCU in standby with the RTC running, plus board leakage
+    float backup_ua;            // MCU in backup mode
+    float lcd_ua;               // SLCD controller and panel
+    float cpu_ua;               // CPU running from the 4 MHz oscillator
+    float wakeup_seconds;       // time the CPU spends awake per interrupt: the ISR plus one pass of the run loop
+    float led_ua[3];            // red, green and blue LED at full duty cycle; 0 if the board has no such LED
+    float buzzer_ua_per_duty;   // piezo buzzer, per percent of duty cycle
+    float tcc_ua;               // TCC0 and its clock while the LEDs or buzzer are on
+    float adc_ua;               // ADC while enabled
+    float adc_read_uas;         // one conversion, including the CPU waiting on it
+    float i2c_transaction_uas;  // one I2C transaction, including the sensor on the other end
+} watch_host_energy_table_t;
+
+static const watch_host_energy_table_t _table =
+#if defined(WATCH_HOST_BOARD_RED)
+    {
+        .board = "sensorwatch_red",
+        .standby_ua = 1.6, .backup_ua = 0.6, .lcd_ua = 1.8,
+        .cpu_ua = 450, .wakeup_seconds = 0.0008,
+        .led_ua = { 4000, 3000, 0 },
+        .buzzer_ua_per_duty = 60, .tcc_ua = 45,
+        .adc_ua = 40, .adc_read_uas = 0.05,
+        .i2c_transaction_uas = 0.3,
+    };
+#elif defined(WATCH_HOST_BOARD_GREEN)
+    {
+        .board = "sensorwatch_green",
+        .standby_ua = 1.6, .backup_ua = 0.6, .lcd_ua = 1.8,
+        .cpu_ua = 450, .wakeup_seconds = 0.0008,
+        .led_ua = { 4000, 3000, 0 },
+        .buzzer_ua_per_duty = 60, .tcc_ua = 45,
+        .adc_ua = 40, .adc_read_uas = 0.05,
+        .i2c_transaction_uas = 0.3,
+    };
+#elif defined(WATCH_HOST_BOARD_BLUE)
+    {
+        .board = "sensorwatch_blue",
+        .standby_ua = 1.6, .backup_ua = 0.6, .lcd_ua = 1.8,
+        .cpu_ua = 450, .wakeup_seconds = 0.0008,
+        .led_ua = { 4000, 0, 2500 },
+        .buzzer_ua_per_duty = 60, .tcc_ua = 45,
+        .adc_ua = 40, .adc_read_uas = 0.05,
+        .i2c_transaction_uas = 0.3,
+    };
+#elif defined(WATCH_HOST_BOARD_PRO)
+    {
+        // The Pro board adds an always-on accelerometer (in its lowest power mode) and an RGB LED.
+        .board = "sensorwatch_pro",
+        .standby_ua = 2.4, .backup_ua = 1.2, .lcd_ua = 2.2,
+        .cpu_ua = 450, .wakeup_seconds = 0.0008,
+        .led_ua = { 3500, 2500, 2500 },
+        .buzzer_ua_per_duty = 60, .tcc_ua = 45,
+        .adc_ua = 40, .adc_read_uas = 0.05,
+        .i2c_transaction_uas = 0.3,
+    };
+#else
+#error "Unknown board; the energy model needs one of WATCH_HOST_BOARD_RED, _GREEN, _BLUE or _PRO."
+#endif
+
+typedef struct {
+    uint64_t ticks;
+    double charge[WATCH_HOST_ENERGY_NUM_COMPONENTS]; // µA·ticks
+} watch_host_energy_account_t;
+
+static const char *_component_names[WATCH_HOST_ENERGY_NUM_COMPONENTS] = {
+    "base", "lcd", "cpu", "led", "buzzer", "tcc", "adc", "i2c"
+};
+
+static bool _initialized;
+static uint64_t _last_update_ticks;
+static float _current[WATCH_HOST_ENERGY_NUM_COMPONENTS];
+
+// the last slot collects whatever is drawn before the first face is activated.
+static watch_host_energy_account_t _accounts[WATCH_HOST_ENERGY_MAX_FACES + 1];
+static void (*_face_functions[WATCH_HOST_ENERGY_MAX_FACES])(void);
+static uint8_t _current_account = WATCH_HOST_ENERGY_MAX_FACES;
+
+static uint8_t _led_color[3];
+static bool _display_enabled;
+static bool _backup_mode;
+
+/// Charges the time since the last update to the current face, at the currents that applied during it.
+static void _watch_host_energy_update(void) {
+    uint64_t now = watch_host_get_elapsed_ticks();
+
+    if (!_initialized) {
+        _initialized = true;
+        _last_update_ticks = now;
+        _current[WATCH_HOST_ENERGY_BASE] = _table.standby_ua;
+        return;
+    }
+
+    uint64_t elapsed = now - _last_update_ticks;
+    if (elapsed == 0) return;
+
+    watch_host_energy_account_t *account = &_accounts[_current_account];
+    account->ticks += elapsed;
+    for (uint8_t i = 0; i < WATCH_HOST_ENERGY_NUM_COMPONENTS; i++) {
+        account->charge[i] += (double)_current[i] * elapsed;
+    }
+    _last_update_ticks = now;
+}
+
+static void _watch_host_energy_set_current(watch_host_energy_component_t component, float microamps) {
+    _watch_host_energy_update();
+    _current[component] = microamps;
+}
+
+static void _watch_host_energy_add_charge(watch_host_energy_component_t component, float microamp_seconds) {
+    _watch_host_energy_update();
+    _accounts[_current_account].charge[component] += (double)microamp_seconds * 128.0;
+}
+
+void _watch_host_energy_wakeup(void) {
+    _watch_host_energy_add_charge(WATCH_HOST_ENERGY_CPU, _table.cpu_ua * _table.wakeup_seconds);
+}
+
+void _watch_host_energy_set_cpu_running(bool running) {
+    _watch_host_energy_set_current(WATCH_HOST_ENERGY_CPU, running ? _table.cpu_ua : 0);
+}
+
+static void _watch_host_energy_update_base(void) {
+    // everything but the RTC and backup registers is powered down in backup mode, the display included.
+    _watch_host_energy_set_current(WATCH_HOST_ENERGY_BASE, _backup_mode ? _table.backup_ua : _table.standby_ua);
+    _watch_host_energy_set_current(WATCH_HOST_ENERGY_LCD, (_display_enabled && !_backup_mode) ? _table.lcd_ua : 0);
+}
+
+void _watch_host_energy_set_backup_mode(bool backup) {
+    _backup_mode = backup;
+    _watch_host_energy_update_base();
+}
+
+void _watch_host_energy_set_display_enabled(bool enabled) {
+    _display_enabled = enabled;
+    _watch_host_energy_update_base();
+}
+
+void _watch_host_energy_set_tcc_enabled(bool enabled) {
+    _watch_host_energy_set_current(WATCH_HOST_ENERGY_TCC, enabled ? _table.tcc_ua : 0);
+}
+
+static void _watch_host_energy_update_leds(void) {
+    float microamps = 0;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        microamps += _table.led_ua[i] * _led_color[i] / 255.0f;
+    }
+
+    _watch_host_energy_set_current(WATCH_HOST_ENERGY_LED, microamps);
+}
+
+void _watch_host_energy_set_led_color(uint8_t red, uint8_t green, uint8_t blue) {
+    _led_color[0] = red;
+    _led_color[1] = green;
+    _led_color[2] = blue;
+    _watch_host_energy_update_leds();
+}
+
+void _watch_host_energy_set_buzzer_duty(uint8_t duty) {
+    _watch_host_energy_set_current(WATCH_HOST_ENERGY_BUZZER, _table.buzzer_ua_per_duty * duty);
+}
+
+void _watch_host_energy_set_adc_enabled(bool enabled) {
+    _watch_host_energy_set_current(WATCH_HOST_ENERGY_ADC, enabled ? _table.adc_ua : 0);
+}
+
+void _watch_host_energy_adc_read(void) {
+    _watch_host_energy_add_charge(WATCH_HOST_ENERGY_ADC, _table.adc_read_uas);
+}
+
+void _watch_host_energy_i2c_transaction(void) {
+    _watch_host_energy_add_charge(WATCH_HOST_ENERGY_I2C, _table.i2c_transaction_uas);
+}
+
+void watch_host_energy_set_face(uint8_t face_index, void (*face_function)(void)) {
+    if (face_index >= WATCH_HOST_ENERGY_MAX_FACES) return;
+
+    _watch_host_energy_update();
+    _current_account = face_index;
+    _face_functions[face_index] = face_function;
+}
+
+static void _watch_host_energy_face_name(uint8_t index, char *buf, size_t len) {
+    Dl_info info;
+
+    if (index == WATCH_HOST_ENERGY_MAX_FACES) {
+        snprintf(buf, len, "(startup)");
+    } else if (_face_functions[index] && dladdr((void *)_face_functions[index], &info) && info.dli_sname) {
+        // faces are named after their functions, e.g. clock_face_setup belongs to clock_face.
+        snprintf(buf, len, "%s", info.dli_sname);
+        char *suffix = strrchr(buf, '_');
+        if (suffix && suffix != buf) *suffix = 0;
+    } else {
+        snprintf(buf, len, "face %d", index);
+    }
+}
+
+static double _watch_host_energy_per_day(double charge, uint64_t ticks) {
+    // µA·ticks over ticks is the average current in µA; over a day that's this many µAh.
+    return ticks ? charge / ticks * WATCH_HOST_ENERGY_HOURS_PER_DAY : 0;
+}
+
+void watch_host_energy_print_report(void) {
+    _watch_host_energy_update();
+
+    watch_host_energy_account_t total = {0};
+    for (uint8_t i = 0; i <= WATCH_HOST_ENERGY_MAX_FACES; i++) {
+        total.ticks += _accounts[i].ticks;
+        for (uint8_t c = 0; c < WATCH_HOST_ENERGY_NUM_COMPONENTS; c++) total.charge[c] += _accounts[i].charge[c];
+    }
+
+    double total_charge = 0;
+    for (uint8_t c = 0; c < WATCH_HOST_ENERGY_NUM_COMPONENTS; c++) total_charge += total.charge[c];
+
+    printf("energy model for %s: %.2f uAh drawn, %.2f uAh/day on average\n",
+           _table.board,
+           total_charge / WATCH_HOST_ENERGY_TICKS_PER_HOUR,
+           _watch_host_energy_per_day(total_charge, total.ticks));
+
+    printf("%-28s %10s %9s", "face", "on screen", "uAh/day");
+    for (uint8_t c = 0; c < WATCH_HOST_ENERGY_NUM_COMPONENTS; c++) printf(" %8s", _component_names[c]);
+    printf("\n");
+
+    for (uint8_t i = 0; i <= WATCH_HOST_ENERGY_MAX_FACES; i++) {
+        watch_host_energy_account_t *account = &_accounts[i];
+        if (account->ticks == 0) continue;
+
+        char name[29];
+        _watch_host_energy_face_name(i, name, sizeof(name));
+
+        double charge = 0;
+        for (uint8_t c = 0; c < WATCH_HOST_ENERGY_NUM_COMPONENTS; c++) charge += account->charge[c];
+
+        printf("%-28s %9.1fs %9.2f", name, account->ticks / 128.0, _watch_host_energy_per_day(charge, account->ticks));
+        for (uint8_t c = 0; c < WATCH_HOST_ENERGY_NUM_COMPONENTS; c++) {
+            printf(" %8.2f", _watch_host_energy_per_day(account->charge[c], account->ticks));
+        }
+        printf("\n");
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file watch_host_energy.h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @addtogroup host_energy Energy Model
+  * @brief This section covers the host backend's energy accounting, which estimates how much charge the
+  *        firmware would draw from the battery on real hardware.
+  * @details The peripheral emulation reports every change in power state (display, LEDs, buzzer, ADC,
+  *          TCC, backup mode) along with one-off costs like waking the CPU or running an I2C transaction.
+  *          The model multiplies the time spent in each state by a per-board current table, and charges
+  *          the result to whichever watch face was active at the time. The numbers are estimates taken
+  *          from datasheets and bench measurements; they are meant for comparing faces against each
+  *          other, not for predicting battery life to the day.
+  */
+/// @{
+
+/// @brief The power consumers the model keeps track of.
+typedef enum {
+    WATCH_HOST_ENERGY_BASE = 0, ///< The MCU in standby (or backup) with the RTC running, plus board leakage.
+    WATCH_HOST_ENERGY_LCD,      ///< The segment LCD controller and panel.
+    WATCH_HOST_ENERGY_CPU,      ///< The CPU running, i.e. every wakeup and any time spent busy-looping.
+    WATCH_HOST_ENERGY_LED,      ///< The LEDs, scaled by their duty cycle.
+    WATCH_HOST_ENERGY_BUZZER,   ///< The piezo buzzer, scaled by its duty cycle.
+    WATCH_HOST_ENERGY_TCC,      ///< The timer that drives the LEDs and buzzer, and its clock.
+    WATCH_HOST_ENERGY_ADC,      ///< The ADC while enabled, plus each conversion.
+    WATCH_HOST_ENERGY_I2C,      ///< I2C transactions, including the sensor on the other end.
+    WATCH_HOST_ENERGY_NUM_COMPONENTS
+} watch_host_energy_component_t;
+
+/** @brief Tells the model which watch face is active; everything drawn from now on is charged to it.
+  * @param face_index The index of the face in the watch_faces array.
+  * @param face_function Any function of the face (its setup function, say). The model looks up its
+  *                      symbol name to label the face in the report.
+  */
+void watch_host_energy_set_face(uint8_t face_index, void (*face_function)(void));
+
+/** @brief Prints the energy report: the estimated draw of each face in µAh per day (that is, what the
+  *        face would cost if it were on screen around the clock), broken down by component.
+  */
+void watch_host_energy_print_report(void);
+
+/// @}
+
+/// Charges the CPU for waking up to service an interrupt. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_wakeup(void);
+
+/// Switches the CPU between running and sleeping. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_set_cpu_running(bool running);
+
+/// Switches the base current between standby and backup mode. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_set_backup_mode(bool backup);
+
+/// Turns the display's share of the current on or off. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_set_display_enabled(bool enabled);
+
+/// Turns the TCC's share of the current on or off. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_set_tcc_enabled(bool enabled);
+
+/// Updates the LED current for a new duty cycle on each channel. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_set_led_color(uint8_t red, uint8_t green, uint8_t blue);
+
+/// Updates the buzzer current for a new duty cycle (in percent), or 0 for off. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_set_buzzer_duty(uint8_t duty);
+
+/// Turns the ADC's share of the current on or off. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_set_adc_enabled(bool enabled);
+
+/// Charges one ADC conversion. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_adc_read(void);
+
+/// Charges one I2C transaction. Called by the host backend; you should not call this from your app.
+void _watch_host_energy_i2c_transaction(void);
@@ -0,0 +1,350 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <limits.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "watch_rtc.h"
+#include "watch_host.h"
+#include "watch_utility.h"
+
+static const uint32_t RTC_CNT_HZ = 128;
+static const uint32_t RTC_CNT_SUBSECOND_MASK = RTC_CNT_HZ - 1;
+static const uint32_t RTC_CNT_DIV = 7;
+static const uint32_t RTC_CNT_TICKS_PER_MINUTE = RTC_CNT_HZ * 60;
+
+static const uint32_t RTC_COMP_GRACE_PERIOD = 4;
+
+static bool rtc_enabled;
+static uint32_t counter;
+static uint32_t reference_timestamp;
+static unix_timestamp_t init_unix_time;
+
+#define WATCH_RTC_N_COMP_CB 8
+
+typedef struct {
+    volatile uint32_t counter;
+    volatile watch_cb_t callback;
+    volatile bool enabled;
+} comp_cb_t;
+
+watch_cb_t tick_callbacks[8];
+comp_cb_t comp_callbacks[WATCH_RTC_N_COMP_CB];
+
+static uint32_t scheduled_comp_counter;
+static bool comp_interrupt_enabled;
+
+watch_cb_t alarm_callback;
+watch_cb_t btn_alarm_callback;
+watch_cb_t a2_callback;
+watch_cb_t a4_callback;
+
+static void _watch_process_periodic_callbacks(void);
+static void _watch_process_comp_callbacks(void);
+
+bool _watch_rtc_is_enabled(void) {
+    return rtc_enabled;
+}
+
+void _watch_rtc_init(void) {
+    for (uint8_t index = 0; index < 8; ++index) {
+        tick_callbacks[index] = NULL;
+    }
+
+    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
+        comp_callbacks[index].counter = 0;
+        comp_callbacks[index].callback = NULL;
+        comp_callbacks[index].enabled = false;
+    }
+
+    scheduled_comp_counter = 0;
+    comp_interrupt_enabled = false;
+    counter = 0;
+
+    watch_rtc_set_date_time(watch_get_init_date_time());
+    watch_rtc_enable(true);
+}
+
+void watch_host_set_init_unix_time(unix_timestamp_t unix_time) {
+    init_unix_time = unix_time;
+}
+
+void watch_rtc_set_date_time(rtc_date_time_t date_time) {
+    watch_rtc_set_unix_time(watch_utility_date_time_to_unix_time(date_time, 0));
+}
+
+rtc_date_time_t watch_rtc_get_date_time(void) {
+    return watch_utility_date_time_from_unix_time(watch_rtc_get_unix_time(), 0);
+}
+
+void watch_rtc_set_unix_time(unix_timestamp_t unix_time) {
+    // unix_time = time_backup + counter / RTC_CNT_HZ - 0.5
+    rtc_counter_t counter = watch_rtc_get_counter();
+    reference_timestamp = unix_time - (counter >> RTC_CNT_DIV) - ((counter & RTC_CNT_SUBSECOND_MASK) >> (RTC_CNT_DIV - 1)) + 1;
+}
+
+unix_timestamp_t watch_rtc_get_unix_time(void) {
+    // unix_time = time_backup + counter / RTC_CNT_HZ - 0.5
+    rtc_counter_t counter = watch_rtc_get_counter();
+    return reference_timestamp + (counter >> RTC_CNT_DIV) + ((counter & RTC_CNT_SUBSECOND_MASK) >> (RTC_CNT_DIV - 1)) - 1;
+}
+
+rtc_counter_t watch_rtc_get_counter(void) {
+    return counter;
+}
+
+uint32_t watch_rtc_get_frequency(void) {
+    return RTC_CNT_HZ;
+}
+
+uint32_t watch_rtc_get_ticks_per_minute(void) {
+    return RTC_CNT_TICKS_PER_MINUTE;
+}
+
+rtc_date_time_t watch_get_init_date_time(void) {
+    // Start from the time passed on the command line, or the host's UTC time if there was none.
+    unix_timestamp_t unix_time = init_unix_time ? init_unix_time : (unix_timestamp_t)time(NULL);
+    rtc_date_time_t date_time = watch_utility_date_time_from_unix_time(unix_time, 0);
+
+#ifdef BUILD_YEAR
+    date_time.unit.year = BUILD_YEAR;
+#endif
+#ifdef BUILD_MONTH
+    date_time.unit.month = BUILD_MONTH;
+#endif
+#ifdef BUILD_DAY
+    date_time.unit.day = BUILD_DAY;
+#endif
+#ifdef BUILD_HOUR
+    date_time.unit.hour = BUILD_HOUR;
+#endif
+#ifdef BUILD_MINUTE
+    date_time.unit.minute = BUILD_MINUTE;
+#endif
+
+    return date_time;
+}
+
+void watch_rtc_register_tick_callback(watch_cb_t callback) {
+    watch_rtc_register_periodic_callback(callback, 1);
+}
+
+void watch_rtc_disable_tick_callback(void) {
+    watch_rtc_disable_periodic_callback(1);
+}
+
+void _watch_host_rtc_tick(void) {
+    if (!rtc_enabled) return;
+
+    counter += 1;
+    // Fire the periodic callbacks that match this counter
+    _watch_process_periodic_callbacks();
+    // Fire the comp callbacks that match this counter
+    _watch_process_comp_callbacks();
+}
+
+uint32_t _watch_host_rtc_ticks_until_next_event(void) {
+    if (!rtc_enabled) return 0;
+
+    uint32_t next = 0;
+
+    if (comp_interrupt_enabled) next = scheduled_comp_counter - counter;
+
+    // PER0 matches every tick. PERn (n = 1..7) matches when the low n bits of the counter are
+    // exactly 1 << (n - 1); see _watch_process_periodic_callbacks below.
+    if (tick_callbacks[0]) return 1;
+    for (uint8_t per_n = 1; per_n < 8; per_n++) {
+        if (tick_callbacks[per_n] == NULL) continue;
+        uint32_t mask = (1 << per_n) - 1;
+        uint32_t ticks = (((1 << (per_n - 1)) - (counter + 1)) & mask) + 1;
+        if (next == 0 || ticks < next) next = ticks;
+    }
+
+    return next;
+}
+
+void _watch_host_rtc_skip(uint32_t ticks) {
+    if (!rtc_enabled) return;
+
+    counter += ticks;
+}
+
+static void _watch_process_periodic_callbacks(void) {
+    // Same firing pattern as the hardware (and the simulator): only one periodic interrupt
+    // can match a given counter value, except 128 Hz which always matches.
+    uint32_t subseconds = counter & RTC_CNT_SUBSECOND_MASK;
+    uint8_t per_n = 0;
+
+    for (uint8_t i = 0; i < 7; i++) {
+        if (subseconds & (1 << i)) {
+            per_n = i + 1;
+            break;
+        }
+    }
+
+    if (tick_callbacks[per_n]) {
+        _watch_host_interrupt();
+        tick_callbacks[per_n]();
+    }
+
+    // 128Hz is always a match
+    if (per_n != 0 && tick_callbacks[0]) {
+        _watch_host_interrupt();
+        tick_callbacks[0]();
+    }
+}
+
+static void _watch_process_comp_callbacks(void) {
+    if (!comp_interrupt_enabled || counter != scheduled_comp_counter) return;
+
+    _watch_host_interrupt();
+    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
+        if (comp_callbacks[index].enabled &&
+            (counter - comp_callbacks[index].counter) < (RTC_COMP_GRACE_PERIOD * 4)
+        ) {
+            comp_callbacks[index].enabled = false;
+            comp_callbacks[index].callback();
+        }
+    }
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_register_periodic_callback(watch_cb_t callback, uint8_t frequency) {
+    // we told them, it has to be a power of 2.
+    if (__builtin_popcount(frequency) != 1) return;
+
+    // this left-justifies the period in a 32-bit integer.
+    uint32_t tmp = (frequency & 0xFF) << 24;
+    // now we can count the leading zeroes to get the value we need.
+    // 0x01 (1 Hz) will have 7 leading zeros for PER7. 0xF0 (128 Hz) will have no leading zeroes for PER0.
+    uint8_t per_n = __builtin_clz(tmp);
+
+    tick_callbacks[per_n] = callback;
+}
+
+void watch_rtc_disable_periodic_callback(uint8_t frequency) {
+    if (__builtin_popcount(frequency) != 1) return;
+    uint8_t per_n = __builtin_clz((frequency & 0xFF) << 24);
+    tick_callbacks[per_n] = NULL;
+}
+
+void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
+    for (int i = 0; i < 8; i++) {
+        if (tick_callbacks[i] && (mask & (1 << i)) != 0) {
+            tick_callbacks[i] = NULL;
+        }
+    }
+}
+
+void watch_rtc_disable_all_periodic_callbacks(void) {
+    watch_rtc_disable_matching_periodic_callbacks(0xFF);
+}
+
+void watch_rtc_schedule_next_comp(void) {
+    rtc_counter_t curr_counter = watch_rtc_get_counter();
+
+    // Same policy as the hardware: if a callback counter has just passed but didn't fire, give it a chance to fire.
+    rtc_counter_t lax_curr_counter = curr_counter - RTC_COMP_GRACE_PERIOD;
+
+    bool schedule_any = false;
+    rtc_counter_t comp_counter = 0;
+    rtc_counter_t min_diff = UINT_MAX;
+
+    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
+        if (comp_callbacks[index].enabled) {
+            rtc_counter_t diff = comp_callbacks[index].counter - lax_curr_counter;
+            if (diff <= min_diff) {
+                min_diff = diff;
+                comp_counter = comp_callbacks[index].counter;
+                schedule_any = true;
+            }
+        }
+    }
+
+    if (schedule_any) {
+        if (comp_counter != scheduled_comp_counter || !comp_interrupt_enabled) {
+            // There is no synchronization delay on the host, so the soonest we can schedule is the next tick.
+            rtc_counter_t earliest_comp_counter = curr_counter + 1;
+            if ((earliest_comp_counter - lax_curr_counter) > (comp_counter - lax_curr_counter)) {
+                comp_counter = earliest_comp_counter;
+            }
+            scheduled_comp_counter = comp_counter;
+            comp_interrupt_enabled = true;
+        }
+    } else {
+        scheduled_comp_counter = lax_curr_counter - RTC_COMP_GRACE_PERIOD;
+        comp_interrupt_enabled = false;
+    }
+}
+
+void watch_rtc_register_comp_callback(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
+    if (index >= WATCH_RTC_N_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].counter = counter;
+    comp_callbacks[index].callback = callback;
+    comp_callbacks[index].enabled = true;
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_register_comp_callback_no_schedule(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
+    if (index >= WATCH_RTC_N_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].counter = counter;
+    comp_callbacks[index].callback = callback;
+    comp_callbacks[index].enabled = true;
+}
+
+void watch_rtc_disable_comp_callback(uint8_t index) {
+    if (index >= WATCH_RTC_N_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].enabled = false;
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_disable_comp_callback_no_schedule(uint8_t index) {
+    if (index >= WATCH_RTC_N_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].enabled = false;
+}
+
+void watch_rtc_enable(bool en) {
+    rtc_enabled = en;
+}
+
+void watch_rtc_freqcorr_write(int16_t value, int16_t sign) {
+    (void) value;
+    (void) sign;
+    // Not emulated; the virtual clock is perfect.
+}
@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "watch_slcd.h"
+#include "watch_common_display.h"
+#include "watch_host.h"
+#include "watch_host_energy.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Segmented Display
+
+// One word per COM line, one bit per SEG line; this is what SDATAHx:SDATALx hold on the SAM L22.
+static uint64_t _segments[4];
+static bool _display_enabled = false;
+static bool _blink_enabled = false;
+static bool _sleep_animation_enabled = false;
+
+static watch_lcd_type_t _installed_display = WATCH_LCD_TYPE_UNKNOWN;
+
+void watch_discover_lcd_type(void) {
+    // There is no panel to probe on the host (and nobody to press a button), so we go with
+    // whatever the build asked for, falling back to the classic LCD.
+#if defined(FORCE_CUSTOM_LCD_TYPE)
+    _installed_display = WATCH_LCD_TYPE_CUSTOM;
+    _watch_update_indicator_segments();
+#else
+    _installed_display = WATCH_LCD_TYPE_CLASSIC;
+#endif
+}
+
+watch_lcd_type_t watch_get_lcd_type(void) {
+    return _installed_display;
+}
+
+void watch_enable_display(void) {
+    // No need to do anything if the display is already enabled.
+    if (_display_enabled) return;
+
+    watch_discover_lcd_type();
+    watch_clear_display();
+    _display_enabled = true;
+    _watch_host_energy_set_display_enabled(true);
+}
+
+void watch_disable_display(void) {
+    _display_enabled = false;
+    _watch_host_energy_set_display_enabled(false);
+}
+
+void _watch_display_write_com(uint8_t com, uint32_t segments) {
+    // COM4 has no segments on either LCD; it only catches the placeholder indicators.
+    if (com >= 4) return;
+
+    _segments[com] = segments;
+}
+
+bool watch_host_get_pixel(uint8_t com, uint8_t seg) {
+    return (_segments[com & 3] >> seg) & 1;
+}
+
+void watch_start_character_blink(char character, uint32_t duration) {
+    (void) duration;
+
+    watch_display_character(character, 7);
+    watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+
+    // The blink itself is done by the SLCD's frame counter without waking the CPU, so there is nothing to emulate.
+    _blink_enabled = true;
+}
+
+void watch_start_indicator_blink_if_possible(watch_indicator_t indicator, uint32_t duration) {
+    (void) duration;
+
+    // Indicators can only blink on the custom LCD.
+    if (_installed_display != WATCH_LCD_TYPE_CUSTOM) return;
+
+    switch (indicator) {
+        case WATCH_INDICATOR_COLON:
+        case WATCH_INDICATOR_LAP:
+        case WATCH_INDICATOR_ARROWS:
+        case WATCH_INDICATOR_SLEEP:
+            watch_set_indicator(indicator);
+            _blink_enabled = true;
+            break;
+        default:
+            return;
+    }
+}
+
+void watch_stop_blink(void) {
+    _blink_enabled = false;
+}
+
+void watch_start_sleep_animation(uint32_t duration) {
+    (void) duration;
+
+    if (_installed_display == WATCH_LCD_TYPE_CUSTOM) {
+        // on pro LCD, we just show the sleep indicator
+        watch_set_indicator(WATCH_INDICATOR_SLEEP);
+    } else {
+        // on classic LCD the "tick/tock" animation is a circular shift done by the SLCD itself
+        watch_display_character(' ', 8);
+        watch_display_character(' ', 9);
+        _sleep_animation_enabled = true;
+    }
+}
+
+bool watch_sleep_animation_is_running(void) {
+    if (_installed_display == WATCH_LCD_TYPE_CUSTOM) {
+        // COM3, SEG0 contains the half moon icon
+        return watch_host_get_pixel(3, 0);
+    } else {
+        return _sleep_animation_enabled;
+    }
+}
+
+void watch_stop_sleep_animation(void) {
+    if (_installed_display == WATCH_LCD_TYPE_CUSTOM) {
+        watch_clear_indicator(WATCH_INDICATOR_SLEEP);
+    } else {
+        _sleep_animation_enabled = false;
+        watch_display_character(' ', 8);
+    }
+}
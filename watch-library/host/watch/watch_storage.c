@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "watch_storage.h"
+#include "watch_host.h"
+
+static uint8_t storage[NVMCTRL_ROW_SIZE * NVMCTRL_RWWEE_PAGES];
+
+bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t size) {
+    if (row * NVMCTRL_ROW_SIZE + offset + size > sizeof(storage)) return false;
+    memcpy(buffer, storage + row * NVMCTRL_ROW_SIZE + offset, size);
+
+    return true;
+}
+
+bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    if (row * NVMCTRL_ROW_SIZE + offset + size > sizeof(storage)) return false;
+    // Like flash, programming can only clear bits; an erase is needed to set them again.
+    uint8_t *dst = storage + row * NVMCTRL_ROW_SIZE + offset;
+    for (uint32_t i = 0; i < size; i++) {
+        dst[i] &= buffer[i];
+    }
+
+    return true;
+}
+
+bool watch_storage_erase(uint32_t row) {
+    if ((row + 1) * NVMCTRL_ROW_SIZE > sizeof(storage)) return false;
+    memset(storage + row * NVMCTRL_ROW_SIZE, 0xff, NVMCTRL_ROW_SIZE);
+
+    return true;
+}
+
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size, watch_storage_cb_t callback) {
+    // there's no controller to wait for, so the operation is already done when the callback runs.
+    if (!watch_storage_write(row, offset, buffer, size)) return false;
+    if (callback != NULL) callback(true);
+
+    return true;
+}
+
+bool watch_storage_erase_async(uint32_t row, watch_storage_cb_t callback) {
+    if (!watch_storage_erase(row)) return false;
+    if (callback != NULL) callback(true);
+
+    return true;
+}
+
+bool watch_storage_is_busy(void) {
+    return false;
+}
+
+bool watch_storage_sync(void) {
+    // nothing to do here!
+    return true;
+}
+
+bool watch_host_storage_load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+
+    bool success = fread(storage, 1, sizeof(storage), f) == sizeof(storage);
+    fclose(f);
+
+    return success;
+}
+
+bool watch_host_storage_save(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return false;
+
+    bool success = fwrite(storage, 1, sizeof(storage), f) == sizeof(storage);
+    fclose(f);
+
+    return success;
+}
@@ -0,0 +1,395 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "watch_tcc.h"
+#include "watch_host.h"
+#include "watch_host_energy.h"
+
+static void (*_cb_tc0)(void) = NULL;
+static void cb_watch_buzzer_seq(void);
+static void cb_watch_buzzer_raw_source(void);
+#ifdef WATCH_BUZZER_DMA
+static void _watch_buzzer_timeline_next_run(void);
+static void _watch_buzzer_timeline_overflow(void);
+#endif
+
+static volatile bool _tc0_running = false;
+static uint16_t _seq_position;
+static int8_t _tone_ticks, _repeat_counter;
+static int8_t *_sequence;
+static watch_buzzer_raw_source_t _raw_source;
+static void* _userdata;
+static uint8_t _volume;
+static void (*_cb_finished)(void);
+static watch_cb_t _cb_start_global = NULL;
+static watch_cb_t _cb_stop_global = NULL;
+static volatile bool _led_is_active = false;
+static volatile bool _buzzer_is_active = false;
+static volatile bool _buzzer_is_on = false;
+static volatile uint32_t _buzzer_period;
+static volatile uint8_t _current_led_color[3] = {0, 0, 0};
+static volatile uint8_t _buzzer_duty;
+
+#ifdef WATCH_BUZZER_DMA
+// Compiled sequences play the way they do on the hardware with WATCH_BUZZER_DMA: TC0 counts out each note's duration, and on every
+// overflow the DMA controller loads the next note without waking the CPU. The CPU only steps in once the DMA has
+// worked through a run, to start it over or start the next one. This is a model of that, so that the energy
+// report counts the same wakeups.
+static watch_buzzer_timeline_t _timeline;
+static bool _timeline_is_playing = false;
+static uint8_t _timeline_run, _timeline_times_left;
+static uint8_t _tc0_count, _tc0_top;
+static uint8_t _dma_next_note, _dma_notes_left;
+#endif
+
+static void _watch_update_energy_model(void) {
+    // TCC0 runs whenever either of its outputs is in use; the LEDs only draw current while it does.
+    _watch_host_energy_set_tcc_enabled(_led_is_active || _buzzer_is_active);
+    if (_led_is_active) {
+        _watch_host_energy_set_led_color(_current_led_color[0], _current_led_color[1], _current_led_color[2]);
+    } else {
+        _watch_host_energy_set_led_color(0, 0, 0);
+    }
+    _watch_host_energy_set_buzzer_duty(_buzzer_is_on ? _buzzer_duty : 0);
+}
+
+void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(void)) {
+    watch_buzzer_play_sequence_with_volume(note_sequence, callback_on_end, WATCH_BUZZER_VOLUME_LOUD);
+}
+
+void watch_buzzer_play_sequence_with_volume(int8_t *note_sequence, void (*callback_on_end)(void), watch_buzzer_volume_t volume) {
+    // Abort any previous sequence
+    watch_buzzer_abort_sequence();
+
+    if (_cb_start_global) {
+        _cb_start_global();
+    }
+
+    watch_enable_buzzer();
+    watch_set_buzzer_off();
+    _sequence = note_sequence;
+    _cb_finished = callback_on_end;
+    _volume = volume == WATCH_BUZZER_VOLUME_SOFT ? 5 : 25;
+    _seq_position = 0;
+    _tone_ticks = 0;
+    _repeat_counter = -1;
+
+#ifdef WATCH_BUZZER_DMA
+    if (watch_buzzer_compile_sequence(note_sequence, &_timeline)) {
+        // arm the first run; the first overflow, one tick from now, loads its first note.
+        _timeline_is_playing = true;
+        _timeline_run = 0;
+        _timeline_times_left = _timeline.num_runs ? _timeline.runs[0].times : 0;
+        _watch_buzzer_timeline_next_run();
+        _tc0_count = 0;
+        _tc0_top = 0;
+        _cb_tc0 = _watch_buzzer_timeline_overflow;
+        _tc0_running = true;
+        return;
+    }
+#endif
+
+    // start the virtual TC0 (for the 64 hz callback)
+    _cb_tc0 = cb_watch_buzzer_seq;
+    _tc0_running = true;
+}
+
+#ifdef WATCH_BUZZER_DMA
+static void _watch_buzzer_timeline_next_run(void) {
+    // what the DMAC interrupt does on the watch, once the DMA has loaded the last note of a run.
+    while (_timeline_run < _timeline.num_runs && _timeline_times_left == 0) {
+        _timeline_run++;
+        if (_timeline_run < _timeline.num_runs) _timeline_times_left = _timeline.runs[_timeline_run].times;
+    }
+
+    if (_timeline_run < _timeline.num_runs) {
+        _timeline_times_left--;
+        _dma_next_note = _timeline.runs[_timeline_run].first;
+        _dma_notes_left = _timeline.runs[_timeline_run].count;
+    } else if (_timeline_run == _timeline.num_runs) {
+        // one more silent note, to find out when the last one ends.
+        _timeline_run++;
+        _dma_next_note = _timeline.num_notes;
+        _dma_notes_left = 1;
+    } else {
+        watch_buzzer_abort_sequence();
+    }
+}
+
+static void _watch_buzzer_timeline_overflow(void) {
+    if (_tc0_count++ < _tc0_top) return;
+    _tc0_count = 0;
+
+    if (_dma_next_note < _timeline.num_notes && _timeline.period[_dma_next_note] != WATCH_BUZZER_PERIOD_REST) {
+        watch_set_buzzer_period_and_duty_cycle(_timeline.period[_dma_next_note], _volume);
+        watch_set_buzzer_on();
+    } else {
+        watch_set_buzzer_off();
+    }
+    _tc0_top = _dma_next_note < _timeline.num_notes ? _timeline.duration[_dma_next_note] - 1 : 0;
+    _dma_next_note++;
+
+    if (--_dma_notes_left == 0) {
+        _watch_host_interrupt();
+        _watch_buzzer_timeline_next_run();
+    }
+}
+#endif // WATCH_BUZZER_DMA
+
+void cb_watch_buzzer_seq(void) {
+    // callback for reading the note sequence
+    if (_tone_ticks == 0) {
+        if (_sequence[_seq_position] < 0 && _sequence[_seq_position + 1]) {
+            // repeat indicator found
+            if (_repeat_counter == -1) {
+                // first encounter: load repeat counter
+                _repeat_counter = _sequence[_seq_position + 1];
+            } else _repeat_counter--;
+            if (_repeat_counter > 0)
+                // rewind
+                if (_seq_position > _sequence[_seq_position] * -2)
+                    _seq_position += _sequence[_seq_position] * 2;
+                else
+                    _seq_position = 0;
+            else {
+                // continue
+                _seq_position += 2;
+                _repeat_counter = -1;
+            }
+        }
+        if (_sequence[_seq_position] && _sequence[_seq_position + 1]) {
+            // read note
+            watch_buzzer_note_t note = _sequence[_seq_position];
+            if (note != BUZZER_NOTE_REST) {
+                watch_set_buzzer_period_and_duty_cycle(NotePeriods[note], _volume);
+                watch_set_buzzer_on();
+            } else watch_set_buzzer_off();
+            // set duration ticks and move to next tone
+            _tone_ticks = _sequence[_seq_position + 1] - 1;
+            _seq_position += 2;
+        } else {
+            // end the sequence
+            watch_buzzer_abort_sequence();
+        }
+    } else _tone_ticks--;
+}
+
+void watch_buzzer_play_raw_source(watch_buzzer_raw_source_t raw_source, void* userdata, watch_cb_t callback_on_end) {
+    watch_buzzer_play_raw_source_with_volume(raw_source, userdata, callback_on_end, WATCH_BUZZER_VOLUME_LOUD);
+}
+
+void watch_buzzer_play_raw_source_with_volume(watch_buzzer_raw_source_t raw_source, void* userdata, watch_cb_t callback_on_end, watch_buzzer_volume_t volume) {
+    // Abort any previous sequence
+    watch_buzzer_abort_sequence();
+
+    if (_cb_start_global) {
+        _cb_start_global();
+    }
+
+    watch_enable_buzzer();
+    watch_set_buzzer_off();
+    _raw_source = raw_source;
+    _userdata = userdata;
+    _cb_finished = callback_on_end;
+    _volume = volume == WATCH_BUZZER_VOLUME_SOFT ? 5 : 25;
+    _seq_position = 0;
+    _tone_ticks = 0;
+
+    // start the virtual TC0 (for the 64 hz callback)
+    _cb_tc0 = cb_watch_buzzer_raw_source;
+    _tc0_running = true;
+}
+
+void cb_watch_buzzer_raw_source(void) {
+    // callback for reading the note sequence
+    uint16_t period;
+    uint16_t duration;
+    bool done;
+
+    if (_tone_ticks == 0) {
+        done = _raw_source(_seq_position, _userdata, &period, &duration);
+
+        if (done || duration == 0) {
+            // end the sequence
+            watch_buzzer_abort_sequence();
+        } else {
+            if (period == WATCH_BUZZER_PERIOD_REST) {
+                watch_set_buzzer_off();
+            } else {
+                watch_set_buzzer_period_and_duty_cycle(period, _volume);
+                watch_set_buzzer_on();
+            }
+
+            // set duration ticks and move to next tone
+            _tone_ticks = duration - 1;
+            _seq_position += 1;
+        }
+    } else {
+        _tone_ticks--;
+    }
+}
+
+void watch_buzzer_abort_sequence(void) {
+    // ends/aborts the sequence
+    if (!_buzzer_is_active) {
+        return;
+    }
+
+    _tc0_running = false;
+#ifdef WATCH_BUZZER_DMA
+    _timeline_is_playing = false;
+#endif
+
+    watch_set_buzzer_off();
+    watch_disable_buzzer();
+
+    if (_cb_stop_global) {
+        _cb_stop_global();
+    }
+
+    if (_cb_finished) {
+        _cb_finished();
+    }
+}
+
+void watch_buzzer_register_global_callbacks(watch_cb_t cb_start, watch_cb_t cb_stop) {
+    _cb_start_global = cb_start;
+    _cb_stop_global = cb_stop;
+}
+
+bool _watch_host_tc0_is_running(void) {
+    return _tc0_running;
+}
+
+void _watch_host_tc0_tick(void) {
+    if (!_tc0_running) return;
+
+#ifdef WATCH_BUZZER_DMA
+    if (_timeline_is_playing) {
+        // DMA, not the CPU, handles most of these.
+        _cb_tc0();
+        return;
+    }
+#endif
+
+    _watch_host_interrupt();
+    if (_cb_tc0) {
+        _cb_tc0();
+    }
+}
+
+void watch_enable_buzzer(void) {
+    _buzzer_is_active = true;
+    _buzzer_period = NotePeriods[BUZZER_NOTE_A4];
+    _buzzer_duty = 25; // the same as WATCH_BUZZER_VOLUME_LOUD
+    _watch_update_energy_model();
+}
+
+void watch_disable_buzzer(void) {
+    _buzzer_is_active = false;
+    watch_set_buzzer_off();
+}
+
+void watch_set_buzzer_period_and_duty_cycle(uint32_t period, uint8_t duty) {
+    _buzzer_period = period;
+    _buzzer_duty = duty;
+    _watch_update_energy_model();
+}
+
+void watch_set_buzzer_on(void) {
+    if (!_buzzer_is_active) return;
+    _buzzer_is_on = true;
+    HAL_GPIO_BUZZER_out();
+    _watch_update_energy_model();
+}
+
+void watch_set_buzzer_off(void) {
+    _buzzer_is_on = false;
+    HAL_GPIO_BUZZER_off();
+    _watch_update_energy_model();
+}
+
+void watch_buzzer_play_note(watch_buzzer_note_t note, uint16_t duration_ms) {
+    watch_buzzer_play_note_with_volume(note, duration_ms, WATCH_BUZZER_VOLUME_LOUD);
+}
+
+void watch_buzzer_play_note_with_volume(watch_buzzer_note_t note, uint16_t duration_ms, watch_buzzer_volume_t volume) {
+    static int8_t single_note_sequence[3];
+
+    single_note_sequence[0] = note;
+    // 64 ticks per second for the tc0
+    // Each tick is approximately 15ms
+    uint16_t duration = duration_ms / 15;
+    if (duration > 127) duration = 127;
+    single_note_sequence[1] = (int8_t)duration;
+    single_note_sequence[2] = 0;
+
+    watch_buzzer_play_sequence_with_volume(single_note_sequence, NULL, volume);
+}
+
+void watch_enable_leds(void) {
+    _led_is_active = true;
+    _watch_update_energy_model();
+}
+
+void watch_disable_leds(void) {
+    _led_is_active = false;
+    _watch_update_energy_model();
+}
+
+void watch_set_led_color(uint8_t red, uint8_t green) {
+#ifdef WATCH_BLUE_TCC_CHANNEL
+    watch_set_led_color_rgb(red, green, 0);
+#else
+    watch_set_led_color_rgb(red, green, green);
+#endif
+}
+
+void watch_set_led_color_rgb(uint8_t red, uint8_t green, uint8_t blue) {
+    _current_led_color[0] = red;
+    _current_led_color[1] = green;
+    _current_led_color[2] = blue;
+
+    if ((red | green | blue) != 0) {
+        watch_enable_leds();
+    } else {
+        watch_disable_leds();
+    }
+    _watch_update_energy_model();
+}
+
+void watch_set_led_red(void) {
+    watch_set_led_color_rgb(255, 0, 0);
+}
+
+void watch_set_led_green(void) {
+    watch_set_led_color_rgb(0, 255, 0);
+}
+
+void watch_set_led_yellow(void) {
+    watch_set_led_color_rgb(255, 255, 0);
+}
+
+void watch_set_led_off(void) {
+    watch_set_led_color_rgb(0, 0, 0);
+}
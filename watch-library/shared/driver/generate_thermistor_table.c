@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Build-time tool: runs on the build machine, solves the thermistor's B equation for the configuration in
+// thermistor_table.h and prints the C source for thermistor_table to stdout. The Makefile runs this for you.
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include "thermistor_table.h"
+
+// The same equation as watch_utility_thermistor_temperature, in double precision.
+static double temperature_at(double value) {
+    double resistance;
+
+    // the ends of the ADC's range are open or short circuits; nudge them to something the equation can take.
+    if (value < 1) value = 1;
+    if (value > 65535) value = 65535;
+
+    if (THERMISTOR_HIGH_SIDE) {
+        resistance = (1023.0 * THERMISTOR_SERIES_RESISTANCE) / (value / 64.0) - THERMISTOR_SERIES_RESISTANCE;
+    } else {
+        resistance = THERMISTOR_SERIES_RESISTANCE / (65535.0 / value - 1.0);
+    }
+    if (!(resistance > 0)) return INFINITY;
+
+    double reading = log(resistance / THERMISTOR_NOMINAL_RESISTANCE) / THERMISTOR_B_COEFFICIENT;
+    reading += 1.0 / (THERMISTOR_NOMINAL_TEMPERATURE + 273.15);
+
+    return 1.0 / reading - 273.15;
+}
+
+int main(void) {
+    printf("// Generated by watch-library/shared/driver/generate_thermistor_table.c from the configuration in\n");
+    printf("// thermistor_table.h. Do not edit.\n\n");
+    printf("#include \"thermistor_table.h\"\n\n");
+    printf("const int16_t thermistor_table[THERMISTOR_TABLE_SIZE] = {\n");
+
+    for (int i = 0; i < THERMISTOR_TABLE_SIZE; i++) {
+        double centi = round(temperature_at(i << THERMISTOR_TABLE_SHIFT) * 100.0);
+        if (!(centi < INT16_MAX)) centi = INT16_MAX;
+        if (centi < -27315) centi = -27315;
+        printf("%s%d,%s", i % 8 ? " " : "    ", (int)centi, i % 8 == 7 || i == THERMISTOR_TABLE_SIZE - 1 ? "\n" : "");
+    }
+
+    printf("};\n");
+
+    return 0;
+}
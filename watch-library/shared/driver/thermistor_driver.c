@@ -25,7 +25,6 @@
 #include "thermistor_driver.h"
 #include "sam.h"
 #include "watch.h"
-#include "watch_utility.h"
 
 // assume we have no thermistor until thermistor_driver_init is called.
 static bool has_thermistor = false;
@@ -104,8 +103,8 @@ void thermistor_driver_disable(void) {
     HAL_GPIO_TS_ENABLE_off();
 }
 
-float thermistor_driver_get_temperature(void) {
-    if (!has_thermistor) return (float) 0xFFFFFFFF;
+int16_t thermistor_driver_get_temperature_centi(void) {
+    if (!has_thermistor) return INT16_MIN;
 
     // set the enable pin to the level that powers the thermistor circuit.
     HAL_GPIO_TS_ENABLE_write(THERMISTOR_ENABLE_VALUE);
@@ -114,5 +113,18 @@ float thermistor_driver_get_temperature(void) {
     // and then set the enable pin to the opposite value to power down the thermistor circuit.
     HAL_GPIO_TS_ENABLE_write(!THERMISTOR_ENABLE_VALUE);
 
-    return watch_utility_thermistor_temperature(value, THERMISTOR_HIGH_SIDE, THERMISTOR_B_COEFFICIENT, THERMISTOR_NOMINAL_TEMPERATURE, THERMISTOR_NOMINAL_RESISTANCE, THERMISTOR_SERIES_RESISTANCE);
+    // interpolate between the table entries on either side of the reading.
+    uint16_t index = value >> THERMISTOR_TABLE_SHIFT;
+    int32_t fraction = value & ((1 << THERMISTOR_TABLE_SHIFT) - 1);
+    int32_t difference = thermistor_table[index + 1] - thermistor_table[index];
+
+    return thermistor_table[index] + (difference * fraction) / (1 << THERMISTOR_TABLE_SHIFT);
+}
+
+float thermistor_driver_get_temperature(void) {
+    int16_t temperature_centi = thermistor_driver_get_temperature_centi();
+
+    if (temperature_centi == INT16_MIN) return (float) 0xFFFFFFFF;
+
+    return temperature_centi / 100.0f;
 }
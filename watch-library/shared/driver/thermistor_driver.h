@@ -25,17 +25,12 @@
 #pragma once
 
 #include "pins.h"
-
-// TODO: Do these belong in movement_config.h? In settings we can set on the watch? In an EEPROM configuration area?
-// Think on this. [joey 11/22]
-#define THERMISTOR_ENABLE_VALUE (false)
-#define THERMISTOR_HIGH_SIDE (true)
-#define THERMISTOR_B_COEFFICIENT (3380.0)
-#define THERMISTOR_NOMINAL_TEMPERATURE (25.0)
-#define THERMISTOR_NOMINAL_RESISTANCE (10000.0)
-#define THERMISTOR_SERIES_RESISTANCE (10000.0)
+#include "thermistor_table.h"
 
 bool thermistor_driver_init(void);
 void thermistor_driver_enable(void);
 void thermistor_driver_disable(void);
 float thermistor_driver_get_temperature(void);
+
+// Returns the temperature in hundredths of a degree Celsius, or INT16_MIN if there's no thermistor.
+int16_t thermistor_driver_get_temperature_centi(void);
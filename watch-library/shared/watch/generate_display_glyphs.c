@@ -0,0 +1,198 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Build-time tool: runs on the build machine, works out what watch_display_character should do for every LCD,
+// position and character, and prints the tables in watch_display_glyphs.h as C source. The Makefile runs this for you.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "watch_common_display.h"
+#include "watch_display_glyphs.h"
+
+// draw() looks every character up in these, so they have to cover exactly the characters in the tables.
+_Static_assert(sizeof(Classic_LCD_Character_Set) == WATCH_DISPLAY_GLYPH_COUNT, "Classic_LCD_Character_Set doesn't match WATCH_DISPLAY_GLYPH_COUNT");
+_Static_assert(sizeof(Custom_LCD_Character_Set) == WATCH_DISPLAY_GLYPH_COUNT, "Custom_LCD_Character_Set doesn't match WATCH_DISPLAY_GLYPH_COUNT");
+
+// what drawing one character does to the display: which segments it touches, and what it leaves them as.
+static uint32_t touched[WATCH_DISPLAY_GLYPH_COMS];
+static uint32_t value[WATCH_DISPLAY_GLYPH_COMS];
+
+static void set_pixel(uint8_t com, uint8_t seg) {
+    touched[com] |= 1ul << seg;
+    value[com] |= 1ul << seg;
+}
+
+static void clear_pixel(uint8_t com, uint8_t seg) {
+    touched[com] |= 1ul << seg;
+    value[com] &= ~(1ul << seg);
+}
+
+// The characters each position can't show, and what to show instead.
+static uint8_t substitute(bool custom, uint8_t character, uint8_t position) {
+    if (custom) {
+        if (character == 'R' && position > 1 && position < 8) character = 'r'; // We can't display uppercase R in these positions
+        else if (character == 'T' && position > 1 && position < 8) character = 't'; // lowercase t is the only option for these positions
+        return character;
+    }
+
+    // special cases for positions 4 and 6
+    if (position == 4 || position == 6) {
+        if (character == '7') character = '&'; // "lowercase" 7
+        else if (character == 'A') character = 'a'; // A needs to be lowercase
+        else if (character == 'o') character = 'O'; // O needs to be uppercase
+        else if (character == 'L') character = '!'; // L needs to be in top half
+        else if (character == 'M' || character == 'm' || character == 'N') character = 'n'; // M and uppercase N need to be lowercase n
+        else if (character == 'c') character = 'C'; // C needs to be uppercase
+        else if (character == 'J') character = 'j'; // same
+        else if (character == 'v' || character == 'V' || character == 'U' || character == 'W' || character == 'w') character = 'u'; // bottom segment duplicated, so show in top half
+        else if (character == 't' || character == 'T') character = '+'; // avoid confusion with uppercase E
+    } else {
+        if (character == 'u') character = 'v'; // we can use the bottom segment; move to lower half
+        else if (character == 'j') character = 'J'; // same but just display a normal J
+        else if (character == '.') character = '_'; // we can use the bottom segment; make dot an underscore
+    }
+    if (position > 1) {
+        if (character == 'T') character = 't'; // uppercase T only works in positions 0 and 1
+    }
+    if (position == 1) {
+        if (character == 'a') character = 'A'; // A needs to be uppercase
+        else if (character == 'o') character = 'O'; // O needs to be uppercase
+        else if (character == 'i') character = 'l'; // I needs to be uppercase (use an l, it looks the same)
+        else if (character == 'n') character = 'N'; // N needs to be uppercase
+        else if (character == 'r') character = 'R'; // R needs to be uppercase
+        else if (character == 'd') character = 'D'; // D needs to be uppercase
+        else if (character == 'v' || character == 'V' || character == 'u') character = 'U'; // side segments shared, make uppercase
+        else if (character == 'b') character = 'B'; // B needs to be uppercase
+        else if (character == 'c') character = 'C'; // C needs to be uppercase
+    } else {
+        if (character == 'R') character = 'r'; // R needs to be lowercase almost everywhere
+    }
+    if (position != 0) {
+        if (character == 'I') character = 'l'; // uppercase I only works in position 0
+    }
+
+    return character;
+}
+
+// This is what watch_display_character did at runtime before these tables existed.
+static void draw(bool custom, uint8_t character, uint8_t position) {
+    memset(touched, 0, sizeof(touched));
+    memset(value, 0, sizeof(value));
+
+    character = substitute(custom, character, position);
+    if (!custom && position == 0) clear_pixel(0, 15); // clear funky ninth segment
+
+    digit_mapping_t segmap = custom ? Custom_LCD_Display_Mapping[position] : Classic_LCD_Display_Mapping[position];
+    uint8_t segdata = custom ? Custom_LCD_Character_Set[character - 0x20] : Classic_LCD_Character_Set[character - 0x20];
+
+    for (int i = 0; i < 8; i++) {
+        if (segmap.segment[i].value != segment_does_not_exist) {
+            if (segdata & 1) set_pixel(segmap.segment[i].address.com, segmap.segment[i].address.seg);
+            else clear_pixel(segmap.segment[i].address.com, segmap.segment[i].address.seg);
+        }
+        segdata = segdata >> 1;
+    }
+
+    // these extra segments only exist on the classic LCD; on the custom one, these addresses belong to positions 5 and 10.
+    if (custom) return;
+    if (character == 'T' && position == 1) set_pixel(1, 12); // add descender
+    else if (position == 0 && (character == 'B' || character == 'D' || character == '@')) set_pixel(0, 15); // add funky ninth segment
+    else if (position == 1 && (character == 'B' || character == 'D' || character == '@')) set_pixel(0, 12); // add funky ninth segment
+}
+
+static int generate(const char *name, bool custom, uint8_t num_positions) {
+    watch_display_position_t positions[WATCH_DISPLAY_MAX_POSITIONS] = {0};
+    static uint32_t glyphs[WATCH_DISPLAY_MAX_POSITIONS][WATCH_DISPLAY_GLYPH_COUNT];
+
+    for (uint8_t position = 0; position < num_positions; position++) {
+        // a position owns every segment any character draws to. each COM line's run of them gets packed into the
+        // glyph after the previous one's.
+        for (int i = 0; i < WATCH_DISPLAY_GLYPH_COUNT; i++) {
+            draw(custom, WATCH_DISPLAY_GLYPH_FIRST + i, position);
+            for (int com = 0; com < WATCH_DISPLAY_GLYPH_COMS; com++) positions[position].mask[com] |= touched[com];
+        }
+        uint8_t offset = 0;
+        for (int com = 0; com < WATCH_DISPLAY_GLYPH_COMS; com++) {
+            uint32_t mask = positions[position].mask[com];
+            if (mask == 0) continue;
+            while (!(mask & (1ul << positions[position].shift[com]))) positions[position].shift[com]++;
+            positions[position].offset[com] = offset;
+            while (mask >> positions[position].shift[com] >> (offset - positions[position].offset[com])) offset++;
+        }
+        if (offset > 32) {
+            fprintf(stderr, "%s position %d: segments are too spread out to pack\n", name, position);
+            return 1;
+        }
+
+        for (int i = 0; i < WATCH_DISPLAY_GLYPH_COUNT; i++) {
+            draw(custom, WATCH_DISPLAY_GLYPH_FIRST + i, position);
+            glyphs[position][i] = 0;
+            for (int com = 0; com < WATCH_DISPLAY_GLYPH_COMS; com++) {
+                // a segment this character doesn't touch would be left as it was. none of the current glyphs do that.
+                if (touched[com] != positions[position].mask[com]) {
+                    fprintf(stderr, "%s position %d: '%c' doesn't draw all of the position\n", name, position, WATCH_DISPLAY_GLYPH_FIRST + i);
+                    return 1;
+                }
+                glyphs[position][i] |= (value[com] >> positions[position].shift[com]) << positions[position].offset[com];
+            }
+        }
+    }
+
+    printf("static const uint32_t %s_glyphs[%d][WATCH_DISPLAY_GLYPH_COUNT] = {\n", name, num_positions);
+    for (uint8_t position = 0; position < num_positions; position++) {
+        printf("    {\n");
+        for (int i = 0; i < WATCH_DISPLAY_GLYPH_COUNT; i++) {
+            printf("%s0x%08x,%s", i % 8 ? " " : "        ", glyphs[position][i], i % 8 == 7 || i == WATCH_DISPLAY_GLYPH_COUNT - 1 ? "\n" : "");
+        }
+        printf("    },\n");
+    }
+    printf("};\n\n");
+
+    printf("const watch_display_glyph_table_t watch_display_glyphs_%s = {\n", name);
+    printf("    .num_positions = %d,\n", num_positions);
+    printf("    .positions = {\n");
+    for (uint8_t position = 0; position < num_positions; position++) {
+        watch_display_position_t *p = &positions[position];
+        printf("        { .mask = { 0x%08x, 0x%08x, 0x%08x, 0x%08x }, .shift = { %d, %d, %d, %d }, .offset = { %d, %d, %d, %d } },\n",
+               p->mask[0], p->mask[1], p->mask[2], p->mask[3], p->shift[0], p->shift[1], p->shift[2], p->shift[3],
+               p->offset[0], p->offset[1], p->offset[2], p->offset[3]);
+    }
+    printf("    },\n");
+    printf("    .glyphs = &%s_glyphs[0][0],\n", name);
+    printf("};\n\n");
+
+    return 0;
+}
+
+int main(void) {
+    printf("// Generated by watch-library/shared/watch/generate_display_glyphs.c. Do not edit.\n\n");
+    printf("#include \"watch_display_glyphs.h\"\n\n");
+
+    if (generate("classic", false, sizeof(Classic_LCD_Display_Mapping) / sizeof(digit_mapping_t))) return 1;
+    if (generate("custom", true, sizeof(Custom_LCD_Display_Mapping) / sizeof(digit_mapping_t))) return 1;
+
+    return 0;
+}
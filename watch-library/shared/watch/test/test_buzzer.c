@@ -0,0 +1,237 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks that watch_buzzer_compile_sequence's timelines play the same notes, for the same number of ticks, as the
+// 64 Hz interpreter that plays sequences by default. Build and run on the host, once for each signal tune, e.g. from
+// this directory (it borrows the TOTP library's copy of Unity):
+//
+//   cc -DWATCH_HOST -DWATCH_HOST_BOARD_PRO -DSIGNAL_TUNE_DEFAULT -I../../../../lib/TOTP/test -I../../../host/gossamer
+//      -I../../../host/watch -I.. -I../../driver -I../../../.. test_buzzer.c ../watch_common_buzzer.c
+//      ../../../../lib/TOTP/test/unity.c -o test_buzzer && ./test_buzzer
+//
+// Building it with -DWATCH_BUZZER_DMA as well checks the host's model of the DMA path, rather than the interpreter.
+
+#include <stdint.h>
+#include <string.h>
+
+// The host backend's buzzer, built into this file so that the test can see what it's playing from one tick to the
+// next.
+#include "../../../host/watch/watch_tcc.c"
+#include "unity.h"
+
+#include "movement_custom_signal_tunes.h"
+
+// The rest of the host backend, which the buzzer reports to.
+volatile uint32_t _host_gpio_output[2];
+
+void _watch_host_interrupt(void) {
+}
+
+void _watch_host_energy_set_tcc_enabled(bool enabled) {
+    (void) enabled;
+}
+
+void _watch_host_energy_set_led_color(uint8_t red, uint8_t green, uint8_t blue) {
+    (void) red;
+    (void) green;
+    (void) blue;
+}
+
+void _watch_host_energy_set_buzzer_duty(uint8_t duty) {
+    (void) duty;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// What the buzzer does for one 64 Hz tick: a note's period, or 0 for silence.
+#define MAX_TICKS 8192
+static uint32_t played[MAX_TICKS];
+static uint32_t expected[MAX_TICKS];
+
+// movement.c's default alarm, which movement_play_alarm_beeps makes variations of.
+static int8_t alarm_tune[] = {
+    BUZZER_NOTE_C8, 3,
+    BUZZER_NOTE_REST, 4,
+    BUZZER_NOTE_C8, 3,
+    BUZZER_NOTE_REST, 4,
+    BUZZER_NOTE_C8, 3,
+    BUZZER_NOTE_REST, 4,
+    BUZZER_NOTE_C8, 5,
+    BUZZER_NOTE_REST, 38,
+    -8, 9,
+    0
+};
+
+static uint16_t play_on_host(int8_t *note_sequence) {
+    uint16_t ticks = 0;
+
+    watch_buzzer_play_sequence(note_sequence, NULL);
+    while (_watch_host_tc0_is_running()) {
+        TEST_ASSERT_LESS_THAN_UINT16(MAX_TICKS, ticks);
+        _watch_host_tc0_tick();
+        played[ticks++] = _buzzer_is_on ? _buzzer_period : 0;
+    }
+
+    return ticks;
+}
+
+static uint16_t play_timeline(const watch_buzzer_timeline_t *timeline) {
+    uint16_t ticks = 0;
+
+    for (uint8_t run = 0; run < timeline->num_runs; run++) {
+        for (uint8_t time = 0; time < timeline->runs[run].times; time++) {
+            for (uint8_t i = 0; i < timeline->runs[run].count; i++) {
+                uint8_t note = timeline->runs[run].first + i;
+                TEST_ASSERT_LESS_THAN_UINT8(timeline->num_notes, note);
+                TEST_ASSERT_NOT_EQUAL(0, timeline->duration[note]);
+                for (uint8_t tick = 0; tick < timeline->duration[note]; tick++) {
+                    TEST_ASSERT_LESS_THAN_UINT16(MAX_TICKS, ticks);
+                    expected[ticks++] = timeline->period[note] == WATCH_BUZZER_PERIOD_REST ? 0 : timeline->period[note];
+                }
+            }
+        }
+    }
+    // and the tick on which the sequence finds its end, and stops.
+    expected[ticks++] = 0;
+
+    return ticks;
+}
+
+static void assert_timeline_plays(int8_t *note_sequence) {
+    watch_buzzer_timeline_t timeline;
+
+    TEST_ASSERT_TRUE(watch_buzzer_compile_sequence(note_sequence, &timeline));
+    uint16_t expected_ticks = play_timeline(&timeline);
+    uint16_t played_ticks = play_on_host(note_sequence);
+    TEST_ASSERT_EQUAL_UINT16(expected_ticks, played_ticks);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, played, played_ticks);
+}
+
+static void test_alarm_tune(void) {
+    assert_timeline_plays(alarm_tune);
+}
+
+static void test_alarm_beeps(void) {
+    // the same as movement_play_alarm_beeps.
+    static int8_t custom_alarm_tune[19];
+    const watch_buzzer_note_t notes[] = {BUZZER_NOTE_C8, BUZZER_NOTE_A7SHARP_B7FLAT, BUZZER_NOTE_C6, BUZZER_NOTE_REST};
+
+    for (uint8_t n = 0; n < sizeof(notes) / sizeof(notes[0]); n++) {
+        for (uint8_t rounds = 1; rounds <= 20; rounds++) {
+            for (uint8_t i = 0; i < 9; i++) {
+                int8_t note = alarm_tune[i * 2];
+                int8_t duration = alarm_tune[i * 2 + 1];
+
+                if (note == BUZZER_NOTE_C8) {
+                    note = notes[n];
+                } else if (note < 0) {
+                    duration = rounds;
+                }
+                custom_alarm_tune[i * 2] = note;
+                custom_alarm_tune[i * 2 + 1] = duration;
+            }
+            custom_alarm_tune[18] = 0;
+
+            assert_timeline_plays(custom_alarm_tune);
+        }
+    }
+}
+
+static void test_signal_tune(void) {
+    watch_buzzer_timeline_t timeline;
+
+    // the longer tunes have too many notes for a timeline, and always play the old way.
+    if (!watch_buzzer_compile_sequence(signal_tune, &timeline)) {
+        TEST_IGNORE_MESSAGE("signal_tune doesn't compile");
+    }
+    assert_timeline_plays(signal_tune);
+}
+
+static void test_face_sequences(void) {
+    // from timer_face, interval_face, tally_face, endless_runner_face and watch_buzzer_play_note.
+    int8_t timer_beep[] = {BUZZER_NOTE_C8, 3, BUZZER_NOTE_REST, 3, -2, 2, BUZZER_NOTE_C8, 5, BUZZER_NOTE_REST, 25, 0};
+    int8_t timer_start[] = {BUZZER_NOTE_C8, 2, 0};
+    int8_t interval_warmup[] = {BUZZER_NOTE_F6, 8, BUZZER_NOTE_REST, 1, -2, 3, 0};
+    int8_t interval_work[] = {BUZZER_NOTE_F6, 8, BUZZER_NOTE_REST, 1, -2, 2, BUZZER_NOTE_C7, 24, 0};
+    int8_t interval_break[] = {BUZZER_NOTE_B6, 15, BUZZER_NOTE_REST, 1, -2, 1, BUZZER_NOTE_B6, 16, 0};
+    int8_t interval_finish[] = {BUZZER_NOTE_C7, 6, BUZZER_NOTE_E7, 6, BUZZER_NOTE_G7, 6, BUZZER_NOTE_C8, 18, 0};
+    int8_t tally_beep[] = {BUZZER_NOTE_E6, 2, BUZZER_NOTE_REST, 3, BUZZER_NOTE_E6, 2, 0};
+    int8_t lose_tune[] = {BUZZER_NOTE_D3, 10, BUZZER_NOTE_C3SHARP_D3FLAT, 10, BUZZER_NOTE_C3, 10, 0};
+    int8_t single_note[] = {BUZZER_NOTE_A4, 127, 0};
+
+    assert_timeline_plays(timer_beep);
+    assert_timeline_plays(timer_start);
+    assert_timeline_plays(interval_warmup);
+    assert_timeline_plays(interval_work);
+    assert_timeline_plays(interval_break);
+    assert_timeline_plays(interval_finish);
+    assert_timeline_plays(tally_beep);
+    assert_timeline_plays(lose_tune);
+    assert_timeline_plays(single_note);
+}
+
+static void test_repeats(void) {
+    // back to the start, one repeat after another, a repeat at the very end, and a repeat of one time.
+    int8_t from_start[] = {BUZZER_NOTE_C5, 2, BUZZER_NOTE_D5, 3, -5, 4, 0};
+    int8_t consecutive[] = {BUZZER_NOTE_C5, 2, -1, 3, BUZZER_NOTE_E5, 1, -1, 2, BUZZER_NOTE_REST, 4, 0};
+    int8_t at_the_end[] = {BUZZER_NOTE_C5, 1, BUZZER_NOTE_D5, 2, -2, 3, 0};
+    int8_t once[] = {BUZZER_NOTE_C5, 3, -1, 1, BUZZER_NOTE_D5, 3, 0};
+
+    assert_timeline_plays(from_start);
+    assert_timeline_plays(consecutive);
+    assert_timeline_plays(at_the_end);
+    assert_timeline_plays(once);
+}
+
+static void test_sequences_that_dont_compile(void) {
+    watch_buzzer_timeline_t timeline;
+    int8_t nested[] = {BUZZER_NOTE_C5, 1, -1, 2, -2, 2, 0};
+    int8_t too_long[2 * (WATCH_BUZZER_TIMELINE_MAX_NOTES + 1) + 1];
+
+    for (uint8_t i = 0; i < WATCH_BUZZER_TIMELINE_MAX_NOTES + 1; i++) {
+        too_long[i * 2] = BUZZER_NOTE_C5 + i % 12;
+        too_long[i * 2 + 1] = 1;
+    }
+    too_long[sizeof(too_long) - 1] = 0;
+
+    TEST_ASSERT_FALSE(watch_buzzer_compile_sequence(nested, &timeline));
+    TEST_ASSERT_FALSE(watch_buzzer_compile_sequence(too_long, &timeline));
+    // which the interpreter still plays.
+    TEST_ASSERT_EQUAL_UINT16(WATCH_BUZZER_TIMELINE_MAX_NOTES + 2, play_on_host(too_long));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_alarm_tune);
+    RUN_TEST(test_alarm_beeps);
+    RUN_TEST(test_signal_tune);
+    RUN_TEST(test_face_sequences);
+    RUN_TEST(test_repeats);
+    RUN_TEST(test_sequences_that_dont_compile);
+    return UNITY_END();
+}
@@ -23,7 +23,109 @@
  */
 
 #include <stdint.h>
+#include "watch_tcc.h"
 
 // note: the buzzer uses a 1 MHz clock. these values were determined by dividing 1,000,000 by the target frequency.
 // i.e. for a 440 Hz tone (A4 on the piano), 1MHz/440Hz = 2273
 const uint16_t NotePeriods[108] = {18182,17161,16197,15288,14430,13620,12857,12134,11453,10811,10204,9631,9091,8581,8099,7645,7216,6811,6428,6068,5727,5405,5102,4816,4545,4290,4050,3822,3608,3405,3214,3034,2863,2703,2551,2408,2273,2145,2025,1911,1804,1703,1607,1517,1432,1351,1276,1204,1136,1073,1012,956,902,851,804,758,716,676,638,602,568,536,506,478,451,426,402,379,358,338,319,301,284,268,253,239,225,213,201,190,179,169,159,150,142,134,127};
+
+// Repeats are resolved by running the sequence the way the 64 Hz interpreter does, without the waiting, and writing
+// down which notes come out. Anything longer than this almost certainly has a repeat marker inside a repeat.
+#define WATCH_BUZZER_TIMELINE_MAX_PLAYED 8192
+
+// Which of the timeline's notes is at a position in the sequence, i.e. how many notes come before it.
+static uint8_t _watch_buzzer_note_index_at(const int8_t *note_sequence, uint16_t position) {
+    uint8_t index = 0;
+
+    for (uint16_t i = 0; i < position; i += 2) {
+        if (note_sequence[i] > 0) index++;
+    }
+
+    return index;
+}
+
+// If the last run is the same notes as the one before it, counts it as another time through that one instead.
+static void _watch_buzzer_timeline_fold(watch_buzzer_timeline_t *timeline) {
+    if (timeline->num_runs < 2) return;
+
+    uint8_t last = timeline->num_runs - 1;
+    if (timeline->runs[last].times == 1 &&
+        timeline->runs[last].first == timeline->runs[last - 1].first &&
+        timeline->runs[last].count == timeline->runs[last - 1].count &&
+        timeline->runs[last - 1].times < UINT8_MAX) {
+        timeline->runs[last - 1].times++;
+        timeline->num_runs--;
+    }
+}
+
+static bool _watch_buzzer_timeline_play(watch_buzzer_timeline_t *timeline, uint8_t index) {
+    if (timeline->num_runs) {
+        uint8_t last = timeline->num_runs - 1;
+
+        if (timeline->runs[last].times == 1 && timeline->runs[last].first + timeline->runs[last].count == index) {
+            timeline->runs[last].count++;
+            return true;
+        }
+        _watch_buzzer_timeline_fold(timeline);
+    }
+
+    if (timeline->num_runs == WATCH_BUZZER_TIMELINE_MAX_RUNS) return false;
+    timeline->runs[timeline->num_runs].first = index;
+    timeline->runs[timeline->num_runs].count = 1;
+    timeline->runs[timeline->num_runs].times = 1;
+    timeline->num_runs++;
+
+    return true;
+}
+
+bool watch_buzzer_compile_sequence(const int8_t *note_sequence, watch_buzzer_timeline_t *timeline) {
+    uint16_t position;
+    int8_t repeat_counter = -1;
+    uint8_t index = 0;
+
+    timeline->num_notes = 0;
+    timeline->num_runs = 0;
+
+    // first the notes themselves, once each.
+    for (position = 0; note_sequence[position] && note_sequence[position + 1]; position += 2) {
+        if (note_sequence[position] < 0) continue;
+        if (note_sequence[position + 1] < 0 || note_sequence[position] > BUZZER_NOTE_REST) return false;
+        if (timeline->num_notes == WATCH_BUZZER_TIMELINE_MAX_NOTES) return false;
+
+        watch_buzzer_note_t note = note_sequence[position];
+        timeline->period[timeline->num_notes] = note == BUZZER_NOTE_REST ? WATCH_BUZZER_PERIOD_REST : NotePeriods[note];
+        timeline->duration[timeline->num_notes] = note_sequence[position + 1];
+        timeline->num_notes++;
+    }
+
+    // then the order they play in, with the same repeat logic as cb_watch_buzzer_seq.
+    position = 0;
+    for (uint16_t played = 0; played < WATCH_BUZZER_TIMELINE_MAX_PLAYED; played++) {
+        if (note_sequence[position] < 0 && note_sequence[position + 1]) {
+            if (repeat_counter == -1) {
+                repeat_counter = note_sequence[position + 1];
+            } else repeat_counter--;
+            if (repeat_counter > 0) {
+                if (position > note_sequence[position] * -2)
+                    position += note_sequence[position] * 2;
+                else
+                    position = 0;
+                index = _watch_buzzer_note_index_at(note_sequence, position);
+            } else {
+                position += 2;
+                repeat_counter = -1;
+            }
+        }
+        if (!(note_sequence[position] && note_sequence[position + 1])) {
+            _watch_buzzer_timeline_fold(timeline);
+            return true;
+        }
+        // rewinding onto another repeat marker is what the format says not to do.
+        if (note_sequence[position] < 0) return false;
+        if (!_watch_buzzer_timeline_play(timeline, index)) return false;
+        index++;
+        position += 2;
+    }
+
+    return false;
+}
@@ -24,10 +24,10 @@
 
 #include "watch_slcd.h"
 #include "watch_common_display.h"
+#include "watch_display_glyphs.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
 
 uint8_t IndicatorSegments[8] = {
     SLCD_SEGID(0, 17), // WATCH_INDICATOR_SIGNAL
@@ -42,133 +42,92 @@ uint8_t IndicatorSegments[8] = {
     SLCD_SEGID(4, 0)   // WATCH_INDICATOR_COLON (does not exist, will set in SDATAL4 which is harmless)
 };
 
-void watch_display_character(uint8_t character, uint8_t position) {
-    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        if (character == 'R' && position > 1 && position < 8) character = 'r'; // We can't display uppercase R in these positions
-        else if (character == 'T' && position > 1 && position < 8) character = 't'; // lowercase t is the only option for these positions
-    } else {
-        // special cases for positions 4 and 6
-        if (position == 4 || position == 6) {
-            if (character == '7') character = '&'; // "lowercase" 7
-            else if (character == 'A') character = 'a'; // A needs to be lowercase
-            else if (character == 'o') character = 'O'; // O needs to be uppercase
-            else if (character == 'L') character = '!'; // L needs to be in top half
-            else if (character == 'M' || character == 'm' || character == 'N') character = 'n'; // M and uppercase N need to be lowercase n
-            else if (character == 'c') character = 'C'; // C needs to be uppercase
-            else if (character == 'J') character = 'j'; // same
-            else if (character == 'v' || character == 'V' || character == 'U' || character == 'W' || character == 'w') character = 'u'; // bottom segment duplicated, so show in top half
-            else if (character == 't' || character == 'T') character = '+'; // avoid confusion with uppercase E
-        } else {
-            if (character == 'u') character = 'v'; // we can use the bottom segment; move to lower half
-            else if (character == 'j') character = 'J'; // same but just display a normal J
-            else if (character == '.') character = '_'; // we can use the bottom segment; make dot an underscore
-        }
-        if (position > 1) {
-            if (character == 'T') character = 't'; // uppercase T only works in positions 0 and 1
-        }
-        if (position == 1) {
-            if (character == 'a') character = 'A'; // A needs to be uppercase
-            else if (character == 'o') character = 'O'; // O needs to be uppercase
-            else if (character == 'i') character = 'l'; // I needs to be uppercase (use an l, it looks the same)
-            else if (character == 'n') character = 'N'; // N needs to be uppercase
-            else if (character == 'r') character = 'R'; // R needs to be uppercase
-            else if (character == 'd') character = 'D'; // D needs to be uppercase
-            else if (character == 'v' || character == 'V' || character == 'u') character = 'U'; // side segments shared, make uppercase
-            else if (character == 'b') character = 'B'; // B needs to be uppercase
-            else if (character == 'c') character = 'C'; // C needs to be uppercase
-        } else {
-            if (character == 'R') character = 'r'; // R needs to be lowercase almost everywhere
-        }
-        if (position == 0) {
-            watch_clear_pixel(0, 15); // clear funky ninth segment
-        } else {
-            if (character == 'I') character = 'l'; // uppercase I only works in position 0
-        }
-    }
-
-    digit_mapping_t segmap;
-    uint8_t segdata;
+// A shadow of the SLCD's SDATALx registers: one word per COM line, one bit per SEG line. Everything below draws
+// into it, and the outermost call commits it, so a string costs a register write per COM line it changed rather
+// than a read-modify-write per segment. COM4 only ever holds the placeholder indicators above.
+#define WATCH_DISPLAY_NUM_COMS 5
+static uint32_t _watch_display_shadow[WATCH_DISPLAY_NUM_COMS];
+static uint8_t _watch_display_dirty_coms;
+static uint8_t _watch_display_update_depth;
 
-    /// TODO: This could be optimized by doing this check once and setting a pointer in watch_discover_lcd_type.
-
-    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        segmap = Custom_LCD_Display_Mapping[position];
-        segdata = Custom_LCD_Character_Set[character - 0x20];
-    } else {
-        segmap = Classic_LCD_Display_Mapping[position];
-        segdata = Classic_LCD_Character_Set[character - 0x20];
-    }
+// Which glyph table to draw from; _watch_update_indicator_segments switches it once we know which LCD is installed.
+static const watch_display_glyph_table_t *_watch_display_glyphs = &watch_display_glyphs_classic;
 
-    for (int i = 0; i < 8; i++) {
-        if (segmap.segment[i].value == segment_does_not_exist) {
-            // Segment does not exist; skip it.
-            segdata = segdata >> 1;
-            continue;
-        }
-        uint8_t com = segmap.segment[i].address.com;
-        uint8_t seg = segmap.segment[i].address.seg;
+void _watch_display_begin_update(void) {
+    _watch_display_update_depth++;
+}
 
-        if (segdata & 1) {
-            watch_set_pixel(com, seg);
-        }
-        else {
-            watch_clear_pixel(com, seg);
-        }
+void _watch_display_end_update(void) {
+    if (--_watch_display_update_depth) return;
 
-        segdata = segdata >> 1;
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+        if (_watch_display_dirty_coms & (1 << com)) _watch_display_write_com(com, _watch_display_shadow[com]);
     }
+    _watch_display_dirty_coms = 0;
+}
+
+void watch_set_pixel(uint8_t com, uint8_t seg) {
+    if (com >= WATCH_DISPLAY_NUM_COMS) return;
 
-    if (character == 'T' && position == 1) watch_set_pixel(1, 12); // add descender
-    else if (position == 0 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 15); // add funky ninth segment
-    else if (position == 1 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 12); // add funky ninth segment
+    _watch_display_begin_update();
+    _watch_display_shadow[com] |= (1ul << seg);
+    _watch_display_dirty_coms |= (1 << com);
+    _watch_display_end_update();
 }
 
-void watch_display_character_lp_seconds(uint8_t character, uint8_t position) {
-    // Will only work for digits and for positions  8 and 9 - but less code & checks to reduce power consumption
+void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    if (com >= WATCH_DISPLAY_NUM_COMS) return;
 
-    digit_mapping_t segmap;
-    uint8_t segdata;
+    _watch_display_begin_update();
+    _watch_display_shadow[com] &= ~(1ul << seg);
+    _watch_display_dirty_coms |= (1 << com);
+    _watch_display_end_update();
+}
 
-    /// TODO: See optimization note above.
+void watch_clear_display(void) {
+    _watch_display_begin_update();
+    memset(_watch_display_shadow, 0, sizeof(_watch_display_shadow));
+    _watch_display_dirty_coms = (1 << WATCH_DISPLAY_NUM_COMS) - 1;
+    _watch_display_end_update();
+}
 
-    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        segmap = Custom_LCD_Display_Mapping[position];
-        segdata = Custom_LCD_Character_Set[character - 0x20];
-    } else {
-        segmap = Classic_LCD_Display_Mapping[position];
-        segdata = Classic_LCD_Character_Set[character - 0x20];
-    }
+void watch_display_character(uint8_t character, uint8_t position) {
+    const watch_display_glyph_table_t *glyphs = _watch_display_glyphs;
 
-    for (int i = 0; i < 8; i++) {
-        if (segmap.segment[i].value == segment_does_not_exist) {
-            // Segment does not exist; skip it.
-            segdata = segdata >> 1;
-            continue;
-        }
-        uint8_t com = segmap.segment[i].address.com;
-        uint8_t seg = segmap.segment[i].address.seg;
+    if (position >= glyphs->num_positions) return;
+    if (character < WATCH_DISPLAY_GLYPH_FIRST || character >= WATCH_DISPLAY_GLYPH_FIRST + WATCH_DISPLAY_GLYPH_COUNT) character = ' ';
 
-        if (segdata & 1) {
-            watch_set_pixel(com, seg);
-        }
-        else {
-            watch_clear_pixel(com, seg);
-        }
+    // every substitution and special segment for this LCD and position is already baked into the glyph.
+    const watch_display_position_t *segments = &glyphs->positions[position];
+    uint32_t glyph = glyphs->glyphs[position * WATCH_DISPLAY_GLYPH_COUNT + character - WATCH_DISPLAY_GLYPH_FIRST];
 
-        segdata = segdata >> 1;
+    _watch_display_begin_update();
+    for (uint8_t com = 0; com < WATCH_DISPLAY_GLYPH_COMS; com++) {
+        uint32_t mask = segments->mask[com];
+        _watch_display_shadow[com] = (_watch_display_shadow[com] & ~mask) | (((glyph >> segments->offset[com]) << segments->shift[com]) & mask);
+        _watch_display_dirty_coms |= (mask != 0) << com;
     }
+    _watch_display_end_update();
+}
+
+void watch_display_character_lp_seconds(uint8_t character, uint8_t position) {
+    // this used to skip the character substitutions to save power; with the glyph tables, everything does.
+    watch_display_character(character, position);
 }
 
 void watch_display_string(const char *string, uint8_t position) {
+    _watch_display_begin_update();
     size_t i = 0;
     while(string[i] != 0) {
         watch_display_character(string[i], position + i);
         i++;
         if (position + i >= 10) break;
     }
+    _watch_display_end_update();
 }
 
 void watch_display_text(watch_position_t location, const char *string) {
+    _watch_display_begin_update();
     switch (location) {
         case WATCH_POSITION_TOP:
         case WATCH_POSITION_TOP_LEFT:
@@ -224,9 +183,11 @@ void watch_display_text(watch_position_t location, const char *string) {
                 else watch_display_character(' ', 10);
             }
     }
+    _watch_display_end_update();
 }
 
 void watch_display_text_with_fallback(watch_position_t location, const char *string, const char *fallback) {
+    _watch_display_begin_update();
     if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
         switch (location) {
             case WATCH_POSITION_TOP:
@@ -242,6 +203,7 @@ void watch_display_text_with_fallback(watch_position_t location, const char *str
                 if (string[1]) {
                     watch_display_character(string[1], 1);
                 } else {
+                    _watch_display_end_update();
                     return;
                 }
                 if (string[2]) {
@@ -278,53 +240,7 @@ void watch_display_text_with_fallback(watch_position_t location, const char *str
     } else {
         watch_display_text(location, fallback);
     }
-}
-
-void watch_display_float_with_best_effort(float value, const char *units) {
-    char buf[8];
-    char buf_fallback[8];
-    const char *blank_units = "  ";
-
-    if (value < -99.9) {
-        watch_clear_decimal_if_available();
-        watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Undflo", " Unflo");
-        return;
-    } else if (value > 199.99) {
-        watch_clear_decimal_if_available();
-        watch_display_text(WATCH_POSITION_BOTTOM, "Ovrflo");
-        return;
-    }
-
-    uint16_t value_times_100 = abs((int)round(value * 100.0));
-    bool set_decimal = true;
-
-    if (value < 0 && value_times_100 != 0) {
-        if (value_times_100 > 999) {
-            // decimal point isn't in the right place for these numbers; use same format as classic.
-            set_decimal = false;
-            snprintf(buf, sizeof(buf), "-%4.1f%s", -value, units ? units : blank_units);
-            snprintf(buf_fallback, sizeof(buf_fallback), "%s", buf);
-        } else {
-            snprintf(buf, sizeof(buf), "-%03d%s", value_times_100 % 1000u, units ? units : blank_units);
-            snprintf(buf_fallback, sizeof(buf_fallback), "-%3.1f%s", -value, units ? units : blank_units);
-        }
-    } else if (value_times_100 > 9999) {
-        snprintf(buf, sizeof(buf), "%5u%s", value_times_100, units ? units : blank_units);
-        snprintf(buf_fallback, sizeof(buf_fallback), "%4.1f%s", value, units ? units : blank_units);
-    } else if (value_times_100 > 999) {
-        snprintf(buf, sizeof(buf), "%4u%s", value_times_100, units ? units : blank_units);
-        snprintf(buf_fallback, sizeof(buf_fallback), "%4.1f%s", value, units ? units : blank_units);
-    } else {
-        snprintf(buf, sizeof(buf), " %03u%s", value_times_100 % 1000u, units ? units : blank_units);
-        snprintf(buf_fallback, sizeof(buf_fallback), "%4.2f%s", value, units ? units : blank_units);
-    }
-
-    watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, buf, buf_fallback);
-    if (set_decimal) {
-        watch_set_decimal_if_available();
-    } else {
-        watch_clear_decimal_if_available();
-    }
+    _watch_display_end_update();
 }
 
 void watch_set_colon(void) {
@@ -370,7 +286,8 @@ void watch_clear_indicator(watch_indicator_t indicator) {
 }
 
 void watch_clear_all_indicators(void) {
-    /// TODO: Optimize this? Can be 3-4 writes to SDATAL registers
+    // one commit at the end, so this is a write or two to the SDATAL registers.
+    _watch_display_begin_update();
     watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
     watch_clear_indicator(WATCH_INDICATOR_BELL);
     watch_clear_indicator(WATCH_INDICATOR_PM);
@@ -378,10 +295,12 @@ void watch_clear_all_indicators(void) {
     watch_clear_indicator(WATCH_INDICATOR_LAP);
     watch_clear_indicator(WATCH_INDICATOR_ARROWS);
     watch_clear_indicator(WATCH_INDICATOR_SLEEP);
+    _watch_display_end_update();
 }
 
 void _watch_update_indicator_segments(void) {
     if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
+        _watch_display_glyphs = &watch_display_glyphs_custom;
         IndicatorSegments[0] = SLCD_SEGID(0, 21); // WATCH_INDICATOR_SIGNAL
         IndicatorSegments[1] = SLCD_SEGID(1, 21); // WATCH_INDICATOR_BELL
         IndicatorSegments[2] = SLCD_SEGID(3, 21); // WATCH_INDICATOR_PM
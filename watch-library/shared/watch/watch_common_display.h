@@ -510,3 +510,17 @@ void watch_display_character(uint8_t character, uint8_t position);
 void watch_display_character_lp_seconds(uint8_t character, uint8_t position);
 
 void _watch_update_indicator_segments(void);
+
+/** @brief Batches drawing: nothing reaches the LCD until the matching _watch_display_end_update. Calls nest, and the
+  *          outermost end commits every COM line that changed.
+  */
+void _watch_display_begin_update(void);
+void _watch_display_end_update(void);
+
+/** @brief Implemented by each platform: sets the segments on one COM line to match the display's shadow copy.
+  * @details Only called for COM lines that were drawn to, and implementations should skip the write if the
+  *          hardware already matches.
+  * @param com the common pin, numbered from 0-4.
+  * @param segments one bit per segment pin.
+  */
+void _watch_display_write_com(uint8_t com, uint32_t segments);
@@ -0,0 +1,219 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_display_format.h"
+#include "watch_common_display.h"
+
+// Writes width characters ending at buf + width, right to left: the digits of magnitude, with a decimal point after
+// the first `decimals` of them and at least one digit before it, then the padding and sign.
+static char *_watch_format(char *buf, uint32_t magnitude, bool negative, uint8_t decimals, uint8_t width, watch_format_pad_t pad) {
+    char *p = buf + width;
+    uint8_t digits = 0;
+    bool point = decimals != 0;
+
+    *p = '\0';
+    while (p > buf) {
+        if (point && digits == decimals) {
+            *--p = '.';
+            point = false;
+            continue;
+        }
+        if (!magnitude && digits > decimals) break;
+        *--p = '0' + magnitude % 10;
+        magnitude /= 10;
+        digits++;
+    }
+
+    if (pad == WATCH_FORMAT_PAD_ZERO) {
+        while (p > buf + negative) *--p = '0';
+    }
+    if (negative && width) {
+        // the sign matters more than a leading digit that didn't fit anyway.
+        if (p == buf) p++;
+        *--p = '-';
+    }
+    while (p > buf) *--p = ' ';
+
+    return buf;
+}
+
+// Like printf's %<width>.<decimals>f: pads to width, but widens rather than dropping digits. Returns the length.
+static uint8_t _watch_format_fixed_at_least(char *buf, int32_t value, uint8_t decimals, uint8_t width) {
+    uint32_t magnitude = value < 0 ? -(uint32_t)value : (uint32_t)value;
+    uint8_t needed = (value < 0) + (decimals != 0) + 1;
+
+    for (uint8_t digits = 1; magnitude >= 10 || digits <= decimals; digits++) {
+        magnitude /= 10;
+        needed++;
+    }
+    if (needed > width) width = needed;
+    watch_format_fixed(buf, value, decimals, width);
+
+    return width;
+}
+
+// The units go after the number, truncated like snprintf into an 8 byte buffer would.
+static void _watch_format_units(char *buf, uint8_t length, const char *units) {
+    if (!units) units = "  ";
+    while (length < 7 && *units) buf[length++] = *units++;
+    buf[length] = '\0';
+}
+
+char *watch_format_uint(char *buf, uint32_t value, uint8_t width, watch_format_pad_t pad) {
+    return _watch_format(buf, value, false, 0, width, pad);
+}
+
+char *watch_format_int(char *buf, int32_t value, uint8_t width, watch_format_pad_t pad) {
+    return _watch_format(buf, value < 0 ? -(uint32_t)value : (uint32_t)value, value < 0, 0, width, pad);
+}
+
+char *watch_format_fixed(char *buf, int32_t value, uint8_t decimals, uint8_t width) {
+    return _watch_format(buf, value < 0 ? -(uint32_t)value : (uint32_t)value, value < 0, decimals, width, WATCH_FORMAT_PAD_SPACE);
+}
+
+bool watch_format_hour(char *buf, uint8_t hour, bool clock_24h, watch_format_pad_t pad) {
+    bool pm = hour >= 12;
+
+    if (!clock_24h) {
+        hour %= 12;
+        if (hour == 0) hour = 12;
+    }
+    watch_format_uint(buf, hour, 2, pad);
+
+    return pm;
+}
+
+void watch_display_uint(watch_position_t location, uint32_t value, uint8_t width, watch_format_pad_t pad) {
+    char buf[11];
+
+    if (width > 10) width = 10;
+    watch_display_text(location, watch_format_uint(buf, value, width, pad));
+}
+
+void watch_display_int(watch_position_t location, int32_t value, uint8_t width, watch_format_pad_t pad) {
+    char buf[11];
+
+    if (width > 10) width = 10;
+    watch_display_text(location, watch_format_int(buf, value, width, pad));
+}
+
+void watch_display_hour(uint8_t hour, bool clock_24h, watch_format_pad_t pad) {
+    char buf[3];
+    bool pm = watch_format_hour(buf, hour, clock_24h, pad);
+
+    _watch_display_begin_update();
+    watch_display_text(WATCH_POSITION_HOURS, buf);
+    if (clock_24h) {
+        watch_set_indicator(WATCH_INDICATOR_24H);
+        watch_clear_indicator(WATCH_INDICATOR_PM);
+    } else {
+        watch_clear_indicator(WATCH_INDICATOR_24H);
+        if (pm) watch_set_indicator(WATCH_INDICATOR_PM);
+        else watch_clear_indicator(WATCH_INDICATOR_PM);
+    }
+    _watch_display_end_update();
+}
+
+// Takes the value in tenths as well as hundredths, so callers with a more precise value can round it once rather
+// than twice (98.947 should be 98.9, not 98.95 and then 99.0).
+static void _watch_display_fixed_with_best_effort(int32_t value_times_100, int32_t value_times_10, const char *units) {
+    char buf[8];
+    char buf_fallback[8];
+    uint8_t length, fallback_length;
+    bool set_decimal = true;
+
+    _watch_display_begin_update();
+
+    if (value_times_100 < -9990) {
+        watch_clear_decimal_if_available();
+        watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "Undflo", " Unflo");
+        _watch_display_end_update();
+        return;
+    } else if (value_times_100 > 19999) {
+        watch_clear_decimal_if_available();
+        watch_display_text(WATCH_POSITION_BOTTOM, "Ovrflo");
+        _watch_display_end_update();
+        return;
+    }
+
+    if (value_times_100 < 0) {
+        uint32_t magnitude = -value_times_100;
+        if (magnitude > 999) {
+            // decimal point isn't in the right place for these numbers; use same format as classic.
+            set_decimal = false;
+            length = _watch_format_fixed_at_least(buf, value_times_10, 1, 5);
+            _watch_format_units(buf, length, units);
+            _watch_format_units(buf_fallback, 0, buf);
+        } else {
+            buf[0] = '-';
+            watch_format_uint(buf + 1, magnitude, 3, WATCH_FORMAT_PAD_ZERO);
+            _watch_format_units(buf, 4, units);
+            // sign it separately, so something like -0.04 keeps its sign even though it rounds to zero.
+            buf_fallback[0] = '-';
+            fallback_length = _watch_format_fixed_at_least(buf_fallback + 1, -value_times_10, 1, 3);
+            _watch_format_units(buf_fallback, fallback_length + 1, units);
+        }
+    } else {
+        if (value_times_100 > 9999) {
+            length = 5;
+            watch_format_uint(buf, value_times_100, 5, WATCH_FORMAT_PAD_SPACE);
+            fallback_length = _watch_format_fixed_at_least(buf_fallback, value_times_10, 1, 4);
+        } else if (value_times_100 > 999) {
+            length = 4;
+            watch_format_uint(buf, value_times_100, 4, WATCH_FORMAT_PAD_SPACE);
+            fallback_length = _watch_format_fixed_at_least(buf_fallback, value_times_10, 1, 4);
+        } else {
+            length = 4;
+            buf[0] = ' ';
+            watch_format_uint(buf + 1, value_times_100, 3, WATCH_FORMAT_PAD_ZERO);
+            fallback_length = _watch_format_fixed_at_least(buf_fallback, value_times_100, 2, 4);
+        }
+        _watch_format_units(buf, length, units);
+        _watch_format_units(buf_fallback, fallback_length, units);
+    }
+
+    watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, buf, buf_fallback);
+    if (set_decimal) {
+        watch_set_decimal_if_available();
+    } else {
+        watch_clear_decimal_if_available();
+    }
+    _watch_display_end_update();
+}
+
+void watch_display_fixed_with_best_effort(int32_t value_times_100, const char *units) {
+    // the custom LCD shows the hundredths with its decimal point; the classic LCD gets tenths (or hundredths, for
+    // small numbers) with the decimal point taking up a character.
+    _watch_display_fixed_with_best_effort(value_times_100, (value_times_100 + (value_times_100 < 0 ? -5 : 5)) / 10, units);
+}
+
+void watch_display_float_with_best_effort(float value, const char *units) {
+    float rounding = value < 0 ? -0.5f : 0.5f;
+
+    // clamp first, so the conversions can't overflow; anything out here shows up as out of range anyway.
+    if (value < -100.0f) value = -100.0f;
+    else if (value > 200.0f) value = 200.0f;
+
+    _watch_display_fixed_with_best_effort((int32_t)(value * 100.0f + rounding), (int32_t)(value * 10.0f + rounding), units);
+}
@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+////< @file watch_display_format.h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch_slcd.h"
+
+/** @addtogroup slcd Segment LCD Display
+  * @brief Integer number formatting.
+  * @details The SAM L22 has no FPU, and snprintf's %f pulls in the soft-float printf, which is large and slow. These
+  *          functions render integers and fixed-point numbers with integer math only. Each one writes exactly
+  *          `width` characters plus a terminating NUL into the buffer you provide, so the buffer needs to be at
+  *          least `width + 1` bytes; the result can go straight to watch_display_text or be pasted into a larger
+  *          string. If a number has more digits than fit, its leading digits are dropped, the same way a two-digit
+  *          minutes field would wrap.
+  */
+/// @{
+
+typedef enum {
+    WATCH_FORMAT_PAD_SPACE = 0, ///< Pad on the left with spaces, like %4d.
+    WATCH_FORMAT_PAD_ZERO,      ///< Pad on the left with zeros, like %04d.
+} watch_format_pad_t;
+
+/** @brief Formats an unsigned integer, right aligned.
+  * @param buf A buffer of at least width + 1 bytes.
+  * @param value The number to format.
+  * @param width The number of characters to write.
+  * @param pad Whether to pad with spaces or zeros.
+  * @return buf, for convenience.
+  */
+char *watch_format_uint(char *buf, uint32_t value, uint8_t width, watch_format_pad_t pad);
+
+/** @brief Formats a signed integer, right aligned.
+  * @details A minus sign goes before any padding zeros ("-05"), or right before the digits when padding with
+  *          spaces (" -5"). Positive numbers get no sign.
+  * @param buf A buffer of at least width + 1 bytes.
+  * @param value The number to format.
+  * @param width The number of characters to write, including the sign.
+  * @param pad Whether to pad with spaces or zeros.
+  * @return buf, for convenience.
+  */
+char *watch_format_int(char *buf, int32_t value, uint8_t width, watch_format_pad_t pad);
+
+/** @brief Formats a fixed-point number with a decimal point, right aligned and padded with spaces.
+  * @details The value is a count of 10^-decimals, so 1234 with 2 decimals is "12.34", and -5 with 1 decimal is
+  *          "-0.5". There is always at least one digit before the decimal point. Round the value to the number
+  *          of decimals you want before calling this; digits are never dropped from the right.
+  * @param buf A buffer of at least width + 1 bytes.
+  * @param value The number to format, scaled by 10^decimals.
+  * @param decimals The number of digits after the decimal point, 0-9. With 0, there is no decimal point.
+  * @param width The number of characters to write, including the sign and the decimal point.
+  * @return buf, for convenience.
+  */
+char *watch_format_fixed(char *buf, int32_t value, uint8_t decimals, uint8_t width);
+
+/** @brief Formats an hour of the day as two characters, for either a 12 or 24 hour clock.
+  * @param buf A buffer of at least 3 bytes.
+  * @param hour The hour, 0-23.
+  * @param clock_24h true to format it as 0-23, false to format it as 1-12.
+  * @param pad Whether to pad single-digit hours with a space or a zero.
+  * @return true if the hour is in the afternoon (12-23), so you can set the PM indicator.
+  */
+bool watch_format_hour(char *buf, uint8_t hour, bool clock_24h, watch_format_pad_t pad);
+
+/** @brief Displays an unsigned integer in one of the display's positions; see watch_format_uint.
+  * @param location The location to display it, e.g. WATCH_POSITION_MINUTES.
+  * @param value The number to display.
+  * @param width The number of characters to write; at most 10.
+  * @param pad Whether to pad with spaces or zeros.
+  */
+void watch_display_uint(watch_position_t location, uint32_t value, uint8_t width, watch_format_pad_t pad);
+
+/** @brief Displays a signed integer in one of the display's positions; see watch_format_int.
+  * @param location The location to display it, e.g. WATCH_POSITION_BOTTOM.
+  * @param value The number to display.
+  * @param width The number of characters to write, including the sign; at most 10.
+  * @param pad Whether to pad with spaces or zeros.
+  */
+void watch_display_int(watch_position_t location, int32_t value, uint8_t width, watch_format_pad_t pad);
+
+/** @brief Displays an hour of the day in the hours position, and sets the PM or 24H indicator to match.
+  * @param hour The hour, 0-23.
+  * @param clock_24h true for a 24 hour clock, false for a 12 hour clock.
+  * @param pad Whether to pad single-digit hours with a space or a zero.
+  */
+void watch_display_hour(uint8_t hour, bool clock_24h, watch_format_pad_t pad);
+
+/**
+ * @brief Displays a number in hundredths as best we can on whatever LCD is available.
+ * @details The integer counterpart to watch_display_float_with_best_effort, which rounds its value and calls this.
+ *          If you already have the value in fixed point (millivolts, hundredths of a degree), call this directly
+ *          and skip the floating point math entirely.
+ * @param value_times_100 The number to display, in hundredths, from -9990 to 19999.
+ * @param units A 1-2 character string to display in the seconds position. Second character may be truncated.
+ */
+void watch_display_fixed_with_best_effort(int32_t value_times_100, const char *units);
+
+/// @}
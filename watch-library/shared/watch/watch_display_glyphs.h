@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Second Movement contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Resolved glyph tables
+ *
+ * Which segments a character lights depends on the LCD, the position and the character, including a long list of
+ * substitutions for characters that a position can't show. None of that changes at runtime, so the build runs it
+ * for every combination (see generate_display_glyphs.c) and stores the result: for each position, the segments it
+ * owns on each COM line, and for each character, the state of those segments packed into 32 bits. Drawing a
+ * character is then a shift and a masked write per COM line.
+ */
+
+#define WATCH_DISPLAY_GLYPH_FIRST (0x20)    // the first character in the tables, a space
+#define WATCH_DISPLAY_GLYPH_COUNT (95)      // through 0x7E, the character sets' last entry
+#define WATCH_DISPLAY_GLYPH_COMS (4)
+#define WATCH_DISPLAY_MAX_POSITIONS (11)
+
+typedef struct {
+    uint32_t mask[WATCH_DISPLAY_GLYPH_COMS];    // the segments this position owns on each COM line
+    uint8_t shift[WATCH_DISPLAY_GLYPH_COMS];    // the lowest segment in each mask
+    uint8_t offset[WATCH_DISPLAY_GLYPH_COMS];   // where each COM line's segments start in a packed glyph
+} watch_display_position_t;
+
+typedef struct {
+    uint8_t num_positions;
+    watch_display_position_t positions[WATCH_DISPLAY_MAX_POSITIONS];
+    const uint32_t *glyphs;     // [num_positions][WATCH_DISPLAY_GLYPH_COUNT]
+} watch_display_glyph_table_t;
+
+extern const watch_display_glyph_table_t watch_display_glyphs_classic;
+extern const watch_display_glyph_table_t watch_display_glyphs_custom;
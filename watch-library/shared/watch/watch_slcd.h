@@ -285,3 +285,6 @@ bool watch_sleep_animation_is_running(void);
   */
 void watch_stop_sleep_animation(void);
 /// @}
+
+// integer and fixed-point number formatting for the display
+#include "watch_display_format.h"
@@ -63,8 +63,21 @@
   *                 ├──────────────┼──────────────┼──────────────┼──────────────┤
   *          Row 31 │   64 bytes   │   64 bytes   │   64 bytes   │   64 bytes   │
   *                 └──────────────┴──────────────┴──────────────┴──────────────┘
+  *
+  *          Programming a page or erasing a row takes a few milliseconds. watch_storage_write and
+  *          watch_storage_erase start the operation and return; the next storage call (or
+  *          watch_storage_sync) waits for it to finish, with the CPU asleep rather than spinning.
+  *          If you'd rather not wait at all, the _async variants call you back when the flash
+  *          controller reports that it's done.
   */
 /// @{
+
+/** @brief A function to be called when an asynchronous write or erase completes.
+  * @param success false if the flash controller reported a programming, lock or command error.
+  * @note On hardware this is called from the flash controller's interrupt handler, so keep it short.
+  */
+typedef void (*watch_storage_cb_t)(bool success);
+
 /** @brief Reads a range of bytes from the storage area.
   * @param row The row you want to read.
   * @param offset The offset from the beginning of the row.
@@ -86,7 +99,29 @@ bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, u
   */
 bool watch_storage_erase(uint32_t row);
 
-/** @brief Waits for any pending writes to complete.
+/** @brief Starts writing bytes to a page in the storage area, and returns without waiting for it to finish.
+  * @param row The row containing the page you want to write.
+  * @param offset The offset from the beginning of the row. Must be a multiple of 64.
+  * @param buffer The buffer containing the bytes you wish to set. It may be reused as soon as this returns.
+  * @param size The number of bytes you wish to write.
+  * @param callback A function to call when the write completes, or NULL.
+  * @return false if the address was out of range, in which case the callback will not be called.
+  */
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size, watch_storage_cb_t callback);
+
+/** @brief Starts erasing a row in the storage area, and returns without waiting for it to finish.
+  * @param row The row you want to erase.
+  * @param callback A function to call when the erase completes, or NULL.
+  * @return false if the row was out of range, in which case the callback will not be called.
+  */
+bool watch_storage_erase_async(uint32_t row, watch_storage_cb_t callback);
+
+/** @brief Checks whether a write or erase is still in progress.
+  */
+bool watch_storage_is_busy(void);
+
+/** @brief Waits for any pending writes to complete, sleeping until the flash controller is ready.
+  * @return false if the last write or erase failed.
   */
 bool watch_storage_sync(void);
 /// @}
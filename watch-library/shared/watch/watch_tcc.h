@@ -130,6 +130,33 @@ typedef enum {
 
 typedef bool (*watch_buzzer_raw_source_t)(uint16_t position, void* userdata, uint16_t* period, uint16_t* duration);
 
+/// @brief The most notes a sequence can have, not counting repeats, for it to be compiled into a timeline.
+#ifndef WATCH_BUZZER_TIMELINE_MAX_NOTES
+#define WATCH_BUZZER_TIMELINE_MAX_NOTES 32
+#endif
+
+/// @brief The most runs of notes a compiled timeline can have; see watch_buzzer_timeline_t.
+#ifndef WATCH_BUZZER_TIMELINE_MAX_RUNS
+#define WATCH_BUZZER_TIMELINE_MAX_RUNS 8
+#endif
+
+/** @brief A note sequence with its repeat markers resolved, ready to be played without interpreting it.
+  * @details The notes are stored once each, in the order they appear in the sequence. Playing the timeline means
+  *          playing each run in turn: notes first to first + count - 1, times over. A run only changes where the
+  *          sequence jumps, so the player only needs to step in at the end of a run, not at every note.
+  */
+typedef struct {
+    uint16_t period[WATCH_BUZZER_TIMELINE_MAX_NOTES];   ///< from NotePeriods, or WATCH_BUZZER_PERIOD_REST.
+    uint8_t duration[WATCH_BUZZER_TIMELINE_MAX_NOTES];  ///< in ticks of 1/64 second, at least 1.
+    struct {
+        uint8_t first;
+        uint8_t count;
+        uint8_t times;
+    } runs[WATCH_BUZZER_TIMELINE_MAX_RUNS];
+    uint8_t num_notes;
+    uint8_t num_runs;
+} watch_buzzer_timeline_t;
+
 /** @addtogroup tcc Buzzer and LED Control (via the TCC peripheral)
   * @brief This section covers functions related to Timer Counter for Control peripheral, which drives the piezo buzzer
   *        embedded in the F-91W's back plate as well as the LED that backlights the display.
@@ -250,6 +277,17 @@ void watch_buzzer_play_raw_source(watch_buzzer_raw_source_t raw_source, void* us
   */
 void watch_buzzer_play_raw_source_with_volume(watch_buzzer_raw_source_t raw_source, void* userdata, watch_cb_t callback_on_end, watch_buzzer_volume_t volume);
 
+/** @brief Compiles a note sequence into a timeline, the way watch_buzzer_play_sequence would play it.
+  * @details With WATCH_BUZZER_DMA (make BUZZER_DMA=1), the buzzer uses this to hand a whole sequence to the
+  *          hardware at once, rather than reading it note by note in an interrupt. It plays sequences that don't
+  *          compile the old way, so this never limits what you can play.
+  * @param note_sequence A sequence in the format described at watch_buzzer_play_sequence.
+  * @param timeline The timeline to fill in.
+  * @return true if the sequence compiled; false if it has too many notes or runs, or repeat markers that don't
+  *         follow the rules (which could loop forever).
+  */
+bool watch_buzzer_compile_sequence(const int8_t *note_sequence, watch_buzzer_timeline_t *timeline);
+
 /** @brief Aborts a playing sequence.
   */
 void watch_buzzer_abort_sequence(void);
@@ -258,6 +296,9 @@ void watch_buzzer_register_global_callbacks(watch_cb_t cb_start, watch_cb_t cb_s
 
 #ifndef __EMSCRIPTEN__
 void irq_handler_tc0(void);
+#ifdef WATCH_BUZZER_DMA
+void irq_handler_dmac(void);
+#endif
 #endif
 
 /** @addtogroup led LED Control
@@ -25,6 +25,7 @@
 #include "watch_slcd.h"
 #include "watch_common_display.h"
 
+#include <string.h>
 #include <emscripten.h>
 #include <emscripten/html5.h>
 
@@ -37,6 +38,9 @@ static long blink_interval_id = - 1;
 static bool tick_state;
 static long tick_interval_id = -1;
 
+// What the page is showing, one word per COM line, so we only touch the segments that changed.
+static uint32_t _segments[4];
+
 watch_lcd_type_t watch_get_lcd_type(void) {
 #if defined(FORCE_CUSTOM_LCD_TYPE)
     return WATCH_LCD_TYPE_CUSTOM;
@@ -58,6 +62,12 @@ void watch_enable_display(void) {
     EM_ASM({document.getElementById("classic").style.display = "";});
 #endif
 
+    // start from a blank page, whatever it was showing.
+    EM_ASM({
+        document.querySelectorAll("[data-com][data-seg]")
+            .forEach((e) => e.style.opacity = 0);
+    });
+    memset(_segments, 0, sizeof(_segments));
     watch_clear_display();
 }
 
@@ -67,25 +77,18 @@ void watch_disable_display(void) {
     EM_ASM({document.getElementById("custom").style.display = "none";});
 }
 
-void watch_set_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 1);
-    }, com, seg);
-}
-
-void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 0);
-    }, com, seg);
-}
-
-void watch_clear_display(void) {
-    EM_ASM({
-        document.querySelectorAll("[data-com][data-seg]")
-            .forEach((e) => e.style.opacity = 0);
-    });
+void _watch_display_write_com(uint8_t com, uint32_t segments) {
+    if (com >= 4) return;
+
+    uint32_t changed = _segments[com] ^ segments;
+    _segments[com] = segments;
+    for (uint8_t seg = 0; changed; seg++, changed >>= 1) {
+        if (!(changed & 1)) continue;
+        EM_ASM({
+            document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
+                .forEach((e) => e.style.opacity = $2);
+        }, com, seg, (segments >> seg) & 1);
+    }
 }
 
 static void watch_invoke_blink_callback(void *userData) {
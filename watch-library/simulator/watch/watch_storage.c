@@ -26,6 +26,25 @@ bool watch_storage_erase(uint32_t row) {
     return true;
 }
 
+bool watch_storage_write_async(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size, watch_storage_cb_t callback) {
+    // there's no controller to wait for, so the operation is already done when the callback runs.
+    if (!watch_storage_write(row, offset, buffer, size)) return false;
+    if (callback != NULL) callback(true);
+
+    return true;
+}
+
+bool watch_storage_erase_async(uint32_t row, watch_storage_cb_t callback) {
+    if (!watch_storage_erase(row)) return false;
+    if (callback != NULL) callback(true);
+
+    return true;
+}
+
+bool watch_storage_is_busy(void) {
+    return false;
+}
+
 bool watch_storage_sync(void) {
     // nothing to do here!
     return true;